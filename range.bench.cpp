@@ -0,0 +1,842 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+// Benchmarks of range adaptors and algorithms against hand-written loops and std::ranges.
+//
+// Usage: range_bench [--filter=<substring>] [--min_time=<seconds>] [--json=<file>]
+// Results are printed as a table, and written as JSON in the format of Google Benchmark if --json is given, so that results
+// of different releases can be compared with its tools. Configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+#include "tc/range/filter_adaptor.h"
+#include "tc/range/transform.h"
+#include "tc/range/concat_adaptor.h"
+#include "tc/range/join_adaptor.h"
+#include "tc/range/zip_range.h"
+#include "tc/range/iota_range.h"
+#include "tc/range/merge_ranges.h"
+#include "tc/algorithm/append.h"
+#include "tc/algorithm/accumulate.h"
+#include "tc/algorithm/sort_streaming.h"
+#include "tc/algorithm/parallel_sort.h"
+#include "tc/algorithm/radix_sort.h"
+#include "tc/string/convert_enc.h"
+#include "tc/string/format.h"
+#include "tc/string/make_c_str.h"
+#include "tc/string/spirit_algorithm.h"
+#include "tc/string/multi_search.h"
+#include "tc/serialize.h"
+#include "tc/small_vector.h"
+#include "tc/enumset.h"
+#include "tc/packed_dense_map.h"
+#include "tc/interval.h"
+#include "tc/interval_map.h"
+#include "tc/variant.h"
+#include "tc/base/large_integer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <queue>
+#include <ranges>
+#include <string>
+
+#define BENCH_CONSTANTS4(pre) (pre ## 0)(pre ## 1)(pre ## 2)(pre ## 3)
+#define BENCH_CONSTANTS16(pre) BENCH_CONSTANTS4(pre ## 0)BENCH_CONSTANTS4(pre ## 1)BENCH_CONSTANTS4(pre ## 2)BENCH_CONSTANTS4(pre ## 3)
+#define BENCH_CONSTANTS64(pre) BENCH_CONSTANTS16(pre ## 0)BENCH_CONSTANTS16(pre ## 1)BENCH_CONSTANTS16(pre ## 2)BENCH_CONSTANTS16(pre ## 3)
+TC_DEFINE_ENUM(EPermission, epermission, BENCH_CONSTANTS64(a)BENCH_CONSTANTS64(b)BENCH_CONSTANTS64(c)BENCH_CONSTANTS16(d0)BENCH_CONSTANTS16(d1)BENCH_CONSTANTS16(d2)) // close to the boost.preprocessor sequence limit
+
+namespace {
+	// Prevents the compiler from optimizing away the computation of t.
+	template<typename T>
+	void do_not_optimize(T const& t) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(t) : "memory");
+#else
+		static T volatile s_t;
+		s_t = t;
+#endif
+	}
+
+	struct options final {
+		std::string m_strFilter;
+		double m_dMinTime = 0.2; // seconds per benchmark
+		std::string m_strJson;
+	};
+
+	struct result final {
+		std::string m_strName;
+		std::size_t m_nIterations;
+		std::size_t m_nItemsPerIteration;
+		double m_dNsPerIteration;
+		double m_dCpuNsPerIteration; // of the whole process, so parallel benchmarks report more CPU time than real time
+	};
+
+	options g_options;
+	tc::vector<result> g_vecresult;
+
+	// Runs func repeatedly for at least g_options.m_dMinTime seconds and records the time per call.
+	// func returns a value depending on the whole computation, which is passed to do_not_optimize.
+	template<typename Func>
+	void benchmark(char const* szGroup, char const* szVariant, std::size_t const nItemsPerIteration, Func func) noexcept {
+		std::string strName = std::string(szGroup) + "/" + szVariant;
+		if( std::string::npos == strName.find(g_options.m_strFilter) ) return;
+
+		using clock = std::chrono::steady_clock;
+		do_not_optimize(func()); // warm up caches and allocators
+		std::size_t nIterations = 1;
+		for(;;) {
+			auto const tpBegin = clock::now();
+			auto const clockBegin = std::clock();
+			for( std::size_t n = 0; n < nIterations; ++n ) {
+				do_not_optimize(func());
+			}
+			auto const dSeconds = std::chrono::duration<double>(clock::now() - tpBegin).count();
+			auto const dCpuSeconds = static_cast<double>(std::clock() - clockBegin) / CLOCKS_PER_SEC;
+			if( g_options.m_dMinTime <= dSeconds || 1000000000 < nIterations ) {
+				double const dNsPerIteration = dSeconds * 1e9 / nIterations;
+				std::printf("%-40s %12.0f ns %10.3f ns/item %10zu iterations\n", strName.c_str(), dNsPerIteration, dNsPerIteration / nItemsPerIteration, nIterations);
+				tc::cont_emplace_back(g_vecresult, result{tc_move(strName), nIterations, nItemsPerIteration, dNsPerIteration, dCpuSeconds * 1e9 / nIterations});
+				return;
+			}
+			// Aim for 1.4 times the minimum time, but grow by at most 10x per round.
+			nIterations = tc::max(nIterations + 1, tc::min(nIterations * 10, static_cast<std::size_t>(nIterations * g_options.m_dMinTime * 1.4 / tc::max(dSeconds, 1e-9))));
+		}
+	}
+
+	void write_json() noexcept {
+		if( g_options.m_strJson.empty() ) return;
+		std::FILE* const pfile = std::fopen(g_options.m_strJson.c_str(), "w");
+		if( !pfile ) {
+			std::fprintf(stderr, "cannot open %s\n", g_options.m_strJson.c_str());
+			return;
+		}
+		std::fprintf(pfile, "{\n  \"context\": {\n    \"executable\": \"range_bench\",\n    \"library_build_type\": \"%s\"\n  },\n  \"benchmarks\": [",
+#ifdef NDEBUG
+			"release"
+#else
+			"debug"
+#endif
+		);
+		bool bFirst = true;
+		for( auto const& result : g_vecresult ) {
+			std::fprintf(pfile, "%s\n    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %zu, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", \"items_per_second\": %.3f}",
+				tc::change(bFirst, false) ? "" : ",",
+				result.m_strName.c_str(),
+				result.m_nIterations,
+				result.m_dNsPerIteration,
+				result.m_dCpuNsPerIteration,
+				result.m_nItemsPerIteration * 1e9 / result.m_dNsPerIteration
+			);
+		}
+		std::fprintf(pfile, "\n  ]\n}\n");
+		std::fclose(pfile);
+	}
+
+	tc::vector<int> make_random_ints(std::size_t const nSize, int const nMax) noexcept {
+		tc::vector<int> vecn;
+		tc::cont_reserve(vecn, nSize);
+		unsigned int nState = 12345;
+		for( std::size_t n = 0; n < nSize; ++n ) {
+			nState = nState * 1103515245u + 12345u;
+			tc::cont_emplace_back(vecn, static_cast<int>((nState >> 8) % static_cast<unsigned int>(nMax)));
+		}
+		return vecn;
+	}
+
+	// Micro benchmarks: adaptor stacks
+
+	void bench_adaptors() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 20;
+		auto const vecn = make_random_ints(c_nSize, 1000);
+		auto const vecn2 = make_random_ints(c_nSize, 1000);
+
+		auto const IsEven = [](int const n) noexcept { return 0 == n % 2; };
+		auto const Square = [](int const n) noexcept { return static_cast<long long>(n) * n; };
+
+		benchmark("filter_transform", "tc", c_nSize, [&]() noexcept {
+			return tc::accumulate(tc::transform(tc::filter(vecn, IsEven), Square), 0ll, tc::fn_assign_plus());
+		});
+		benchmark("filter_transform", "loop", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( int const n : vecn ) {
+				if( IsEven(n) ) nSum += Square(n);
+			}
+			return nSum;
+		});
+		benchmark("filter_transform", "std::ranges", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( auto const n : vecn | std::views::filter(IsEven) | std::views::transform(Square) ) nSum += n;
+			return nSum;
+		});
+
+		benchmark("concat", "tc", 2 * c_nSize, [&]() noexcept {
+			return tc::accumulate(tc::concat(vecn, vecn2), 0ll, tc::fn_assign_plus());
+		});
+		benchmark("concat", "loop", 2 * c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( int const n : vecn ) nSum += n;
+			for( int const n : vecn2 ) nSum += n;
+			return nSum;
+		});
+
+		tc::vector<tc::vector<int>> vecvecn;
+		for( std::size_t n = 0; n < c_nSize; n += 100 ) {
+			vecvecn.emplace_back(tc::begin(vecn) + n, tc::begin(vecn) + tc::min(n + 100, c_nSize));
+		}
+		benchmark("join", "tc", c_nSize, [&]() noexcept {
+			return tc::accumulate(tc::join(vecvecn), 0ll, tc::fn_assign_plus());
+		});
+		benchmark("join", "loop", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( auto const& vecnInner : vecvecn ) {
+				for( int const n : vecnInner ) nSum += n;
+			}
+			return nSum;
+		});
+		benchmark("join", "std::ranges", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( int const n : vecvecn | std::views::join ) nSum += n;
+			return nSum;
+		});
+
+		benchmark("zip_transform", "tc", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			tc::for_each(tc::zip(vecn, vecn2), [&](int const n, int const n2) noexcept { nSum += static_cast<long long>(n) * n2; });
+			return nSum;
+		});
+		benchmark("zip_transform", "loop", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( std::size_t n = 0; n < c_nSize; ++n ) nSum += static_cast<long long>(vecn[n]) * vecn2[n];
+			return nSum;
+		});
+		benchmark("zip_transform", "std::ranges", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( auto const n : std::views::iota(std::size_t(0), c_nSize) | std::views::transform([&](std::size_t const n) noexcept { return static_cast<long long>(vecn[n]) * vecn2[n]; }) ) nSum += n;
+			return nSum;
+		});
+	}
+
+	// Micro benchmarks: building containers
+
+	void bench_append() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 20;
+		auto const vecn = make_random_ints(c_nSize, 1000);
+		auto const IsEven = [](int const n) noexcept { return 0 == n % 2; };
+
+		benchmark("append_filter", "tc", c_nSize, [&]() noexcept {
+			return tc::size_raw(tc::make_vector(tc::filter(vecn, IsEven)));
+		});
+		benchmark("append_filter", "loop", c_nSize, [&]() noexcept {
+			tc::vector<int> vecnOut;
+			for( int const n : vecn ) {
+				if( IsEven(n) ) vecnOut.push_back(n);
+			}
+			return vecnOut.size();
+		});
+		benchmark("append_filter", "std::ranges", c_nSize, [&]() noexcept {
+			tc::vector<int> vecnOut;
+			std::ranges::copy_if(vecn, std::back_inserter(vecnOut), IsEven);
+			return vecnOut.size();
+		});
+
+		benchmark("append_iota", "tc", c_nSize, [&]() noexcept {
+			return tc::size_raw(tc::make_vector(tc::iota(0, static_cast<int>(c_nSize))));
+		});
+		benchmark("append_iota", "loop", c_nSize, [&]() noexcept {
+			tc::vector<int> vecnOut;
+			vecnOut.reserve(c_nSize);
+			for( int n = 0; n < static_cast<int>(c_nSize); ++n ) vecnOut.push_back(n);
+			return vecnOut.size();
+		});
+		benchmark("append_iota", "std::ranges", c_nSize, [&]() noexcept {
+			auto const rngn = std::views::iota(0, static_cast<int>(c_nSize));
+			tc::vector<int> vecnOut(rngn.begin(), rngn.end());
+			return vecnOut.size();
+		});
+
+		// adjacency lists: mostly a few entries, sometimes many
+		static constexpr std::size_t c_nNodes = 1 << 14;
+		auto const vecnDegree = make_random_ints(c_nNodes, 16);
+		auto const AdjacencyLists = [&](auto vecvec) noexcept {
+			vecvec.resize(c_nNodes);
+			for( std::size_t i = 0; i < c_nNodes; ++i ) {
+				int const nDegree = 0 == i % 1024 ? 1000 : vecnDegree[i] % 8;
+				for( int n = 0; n < nDegree; ++n ) tc::cont_emplace_back(vecvec[i], n);
+			}
+			std::size_t nEdges = 0;
+			for( auto const& vec : vecvec ) nEdges += tc::size(vec);
+			return nEdges;
+		};
+		benchmark("adjacency_lists", "small_vector", c_nNodes, [&]() noexcept {
+			return AdjacencyLists(tc::vector<tc::small_vector<int, 8>>());
+		});
+		benchmark("adjacency_lists", "vector", c_nNodes, [&]() noexcept {
+			return AdjacencyLists(tc::vector<tc::vector<int>>());
+		});
+	}
+
+	// Macro benchmarks: algorithms
+
+	void bench_sort_streaming() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 20;
+		static constexpr std::size_t c_nTop = 100;
+		auto const vecn = make_random_ints(c_nSize, 1 << 30);
+
+		benchmark("top_100", "tc::sort_streaming", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			std::size_t nCount = 0;
+			tc::for_each(tc::sort_streaming(vecn), [&](int const n) noexcept {
+				nSum += n;
+				return tc::continue_if(c_nTop != ++nCount);
+			});
+			return nSum;
+		});
+		benchmark("top_100", "tc::sort_streaming_top_k", c_nSize, [&]() noexcept {
+			return tc::accumulate(tc::sort_streaming_top_k(vecn, c_nTop), 0ll, tc::fn_assign_plus());
+		});
+		benchmark("top_100", "loop", c_nSize, [&]() noexcept {
+			tc::vector<int> vecnTop(c_nTop);
+			std::partial_sort_copy(vecn.begin(), vecn.end(), vecnTop.begin(), vecnTop.end());
+			long long nSum = 0;
+			for( int const n : vecnTop ) nSum += n;
+			return nSum;
+		});
+		benchmark("top_100", "std::ranges", c_nSize, [&]() noexcept {
+			tc::vector<int> vecnTop(c_nTop);
+			std::ranges::partial_sort_copy(vecn, vecnTop);
+			long long nSum = 0;
+			for( int const n : vecnTop ) nSum += n;
+			return nSum;
+		});
+
+		// The parallel variants only pay off with several hardware threads.
+		benchmark("sort", "tc::sort_inplace", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecn;
+			tc::sort_inplace(vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+		benchmark("sort", "tc::sort_inplace(tc::par)", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecn;
+			tc::sort_inplace(tc::par, vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+		tc::vector<std::uint64_t> vecnId;
+		for( int const n : vecn ) tc::cont_emplace_back(vecnId, static_cast<std::uint64_t>(n) * 0x9e3779b97f4a7c15ull);
+		benchmark("sort_ids", "tc::sort_inplace", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecnId;
+			tc::sort_inplace(vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+		tc::radix_scratch scratch;
+		benchmark("sort_ids", "tc::sort_inplace(tc::radix)", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecnId;
+			tc::sort_inplace(tc::radix.scratch(scratch), vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+		benchmark("stable_sort", "tc::stable_sort_inplace", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecn;
+			tc::stable_sort_inplace(vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+		benchmark("stable_sort", "tc::stable_sort_inplace(tc::par)", c_nSize, [&]() noexcept {
+			auto vecnSorted = vecn;
+			tc::stable_sort_inplace(tc::par, vecnSorted);
+			return vecnSorted[c_nSize / 2];
+		});
+	}
+
+	void bench_merge_many() noexcept {
+		static constexpr std::size_t c_nRuns = 256;
+		static constexpr std::size_t c_nRunSize = 4096;
+		tc::vector<tc::vector<int>> vecvecn;
+		for( std::size_t nRun = 0; nRun < c_nRuns; ++nRun ) {
+			auto vecn = make_random_ints(c_nRunSize, 1 << 30);
+			std::ranges::sort(vecn);
+			tc::cont_emplace_back(vecvecn, tc_move(vecn));
+		}
+
+		benchmark("merge_many", "tc", c_nRuns * c_nRunSize, [&]() noexcept {
+			return tc::accumulate(tc::merge_many(vecvecn), 0ll, tc::fn_assign_plus());
+		});
+		benchmark("merge_many", "loop", c_nRuns * c_nRunSize, [&]() noexcept {
+			using pair_t = std::pair<int, std::size_t>;
+			tc::vector<std::size_t> vecnPos(c_nRuns);
+			std::priority_queue<pair_t, tc::vector<pair_t>, std::greater<pair_t>> queue;
+			for( std::size_t nRun = 0; nRun < c_nRuns; ++nRun ) queue.emplace(vecvecn[nRun][0], nRun);
+			long long nSum = 0;
+			while( !queue.empty() ) {
+				auto const [n, nRun] = queue.top();
+				queue.pop();
+				nSum += n;
+				if( ++vecnPos[nRun] < vecvecn[nRun].size() ) queue.emplace(vecvecn[nRun][vecnPos[nRun]], nRun);
+			}
+			return nSum;
+		});
+	}
+
+	void bench_convert_enc() noexcept {
+		tc::string<char> str;
+		for( int n = 0; n < 50000; ++n ) {
+			tc::append(str, "2023-06-01 12:00:00 INFO request served in ", tc::as_dec(n), " ms");
+			if( 0 == n % 8 ) tc::append(str, " \xc3\xa4\xe2\x82\xac");
+			tc::append(str, "\n");
+		}
+
+		benchmark("utf8_to_utf16", "tc", tc::size_raw(str), [&]() noexcept {
+			return tc::size_raw(tc::make_str(tc::convert_enc<tc::char16>(str)));
+		});
+		benchmark("utf8_to_utf16", "loop", tc::size_raw(str), [&]() noexcept {
+			tc::string<tc::char16> str16;
+			str16.reserve(str.size());
+			auto const* pch = reinterpret_cast<unsigned char const*>(str.data());
+			auto const* const pchEnd = pch + str.size();
+			while( pch != pchEnd ) { // valid input assumed
+				unsigned int n = *pch++;
+				if( 0xf0 <= n ) {
+					n = (n & 0x07) << 18 | (pch[0] & 0x3f) << 12 | (pch[1] & 0x3f) << 6 | (pch[2] & 0x3f);
+					pch += 3;
+					n -= 0x10000;
+					str16.push_back(static_cast<tc::char16>(0xd800 + (n >> 10)));
+					str16.push_back(static_cast<tc::char16>(0xdc00 + (n & 0x3ff)));
+					continue;
+				} else if( 0xe0 <= n ) {
+					n = (n & 0x0f) << 12 | (pch[0] & 0x3f) << 6 | (pch[1] & 0x3f);
+					pch += 2;
+				} else if( 0xc0 <= n ) {
+					n = (n & 0x1f) << 6 | (pch[0] & 0x3f);
+					pch += 1;
+				}
+				str16.push_back(static_cast<tc::char16>(n));
+			}
+			return str16.size();
+		});
+
+		auto const str16 = tc::make_str(tc::convert_enc<tc::char16>(str));
+		benchmark("utf16_to_utf8", "tc", tc::size_raw(str16), [&]() noexcept {
+			return tc::size_raw(tc::make_str(tc::convert_enc<char>(str16)));
+		});
+	}
+
+	void bench_format() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 16;
+		auto const vecn = make_random_ints(c_nSize, 1 << 30);
+
+		benchmark("format_dec", "tc", c_nSize, [&]() noexcept {
+			tc::string<char> str;
+			tc::for_each(vecn, [&](int const n) noexcept { tc::append(str, tc::as_dec(n), ","); });
+			return str.size();
+		});
+		benchmark("format_dec", "loop", c_nSize, [&]() noexcept {
+			tc::string<char> str;
+			char ach[16];
+			for( int const n : vecn ) {
+				auto const pchEnd = std::to_chars(ach, ach + sizeof(ach), n).ptr;
+				str.append(ach, pchEnd);
+				str.push_back(',');
+			}
+			return str.size();
+		});
+		benchmark("format_dec", "snprintf", c_nSize, [&]() noexcept {
+			tc::string<char> str;
+			char ach[16];
+			for( int const n : vecn ) {
+				str.append(ach, std::snprintf(ach, sizeof(ach), "%d,", n));
+			}
+			return str.size();
+		});
+
+		tc::vector<double> vecd;
+		for( int const n : vecn ) tc::cont_emplace_back(vecd, n / 1024.0);
+		benchmark("format_float", "tc", c_nSize, [&]() noexcept {
+			tc::string<char> str;
+			tc::for_each(vecd, [&](double const d) noexcept { tc::append(str, tc::as_dec(d), ","); });
+			return str.size();
+		});
+		benchmark("format_float", "snprintf", c_nSize, [&]() noexcept {
+			tc::string<char> str;
+			char ach[32];
+			for( double const d : vecd ) {
+				str.append(ach, std::snprintf(ach, sizeof(ach), "%.17g,", d));
+			}
+			return str.size();
+		});
+
+		tc::string<char> const strDir("/var/tmp/");
+		benchmark("make_c_str", "small_string", c_nSize, [&]() noexcept {
+			std::size_t n = 0;
+			for( int const nFile : vecn ) {
+				n += std::strlen(tc::make_c_str(strDir, tc::as_dec(nFile), ".txt"));
+			}
+			return n;
+		});
+		benchmark("make_c_str", "string", c_nSize, [&]() noexcept {
+			std::size_t n = 0;
+			for( int const nFile : vecn ) {
+				n += std::strlen(tc::as_c_str(tc::make_str<char>(strDir, tc::as_dec(nFile), ".txt")));
+			}
+			return n;
+		});
+	}
+
+	void bench_from_string() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 16;
+		auto const vecn = make_random_ints(c_nSize, 1 << 30);
+		tc::string<char> strInts;
+		tc::string<char> strFloats;
+		for( int const n : vecn ) {
+			tc::append(strInts, tc::as_dec(n), ",");
+			tc::append(strFloats, tc::as_dec(n / 1000), ".", tc::as_dec(n % 1000), ",");
+		}
+
+		benchmark("parse_dec", "tc", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( auto rng = tc::make_iterator_range(strInts.data(), strInts.data() + strInts.size()); !tc::empty(rng); ) {
+				auto const pairnit = tc::unsigned_integer_from_string_head<unsigned int>(rng);
+				nSum += pairnit.first;
+				rng = tc::make_iterator_range(pairnit.second + 1, tc::end(rng));
+			}
+			return nSum;
+		});
+		benchmark("parse_dec", "from_chars", c_nSize, [&]() noexcept {
+			long long nSum = 0;
+			for( char const* pch = strInts.data(); pch != strInts.data() + strInts.size(); ) {
+				unsigned int n;
+				pch = std::from_chars(pch, strInts.data() + strInts.size(), n).ptr + 1;
+				nSum += n;
+			}
+			return nSum;
+		});
+		benchmark("parse_float", "tc", c_nSize, [&]() noexcept {
+			double dSum = 0;
+			for( auto rng = tc::make_iterator_range(strFloats.data(), strFloats.data() + strFloats.size()); !tc::empty(rng); ) {
+				auto const pairdit = tc::float_from_string_head<double>(rng);
+				dSum += pairdit.first;
+				rng = tc::make_iterator_range(pairdit.second + 1, tc::end(rng));
+			}
+			return dSum;
+		});
+		benchmark("parse_float", "strtod", c_nSize, [&]() noexcept {
+			double dSum = 0;
+			for( char const* pch = strFloats.data(); pch != strFloats.data() + strFloats.size(); ) {
+				char* pchEnd;
+				dSum += std::strtod(pch, &pchEnd);
+				pch = pchEnd + 1;
+			}
+			return dSum;
+		});
+	}
+
+	void bench_deserialize() noexcept {
+		static constexpr std::size_t c_nSize = 1 << 16;
+		tc::vector<tc::string<char>> vecstr;
+		for( int const n : make_random_ints(c_nSize, 1 << 30) ) tc::cont_emplace_back(vecstr, tc::make_str<char>("item ", tc::as_dec(n)));
+		auto const vecb = tc::make_vector(tc::serialize(vecstr));
+
+		benchmark("deserialize", "copy", c_nSize, [&]() noexcept {
+			return tc::deserialize<tc::vector<tc::string<char>>>(vecb).size();
+		});
+		benchmark("deserialize", "span", c_nSize, [&]() noexcept {
+			tc::vector<tc::span<char const>> vecspan;
+			tc::cont_reserve(vecspan, c_nSize);
+			tc::deserializer deserializer(vecb);
+			for( auto n = deserializer.read<std::uint32_t>(); 0 < n; --n ) tc::cont_emplace_back(vecspan, deserializer.read<tc::span<char const>>());
+			return vecspan.size();
+		});
+	}
+
+	void bench_search() noexcept {
+		tc::string<char> str;
+		for( int n = 0; n < 50000; ++n ) {
+			tc::append(str, "2023-06-01 12:00:00 INFO request ", tc::as_dec(n), " served in ", tc::as_dec(n % 1000), " ms\n");
+		}
+		// "ERROR" does not occur, so its search scans the whole haystack.
+		tc::string<char> const astrNeedle[] = {"ERROR", "request 49999 served", "2023-06-01 12:00:00 INFO request 49999 served in 999 ms"};
+
+		for( auto const& strNeedle : astrNeedle ) {
+			auto const strGroup = tc::make_str("search/", tc::as_dec(tc::size_raw(strNeedle)));
+			auto const searcher = tc::make_searcher(strNeedle);
+			benchmark(strGroup.c_str(), "tc_searcher", tc::size_raw(str), [&]() noexcept {
+				return tc::search_first<tc::return_bool>(str, searcher);
+			});
+			benchmark(strGroup.c_str(), "tc_naive", tc::size_raw(str), [&]() noexcept {
+				return tc::search_first<tc::return_bool>(str, strNeedle);
+			});
+			benchmark(strGroup.c_str(), "std_find", tc::size_raw(str), [&]() noexcept {
+				return str.find(strNeedle);
+			});
+		}
+
+		tc::vector<tc::string<char>> vecstrPattern;
+		for( int n = 0; n < 40; ++n ) {
+			tc::cont_emplace_back(vecstrPattern, tc::make_str("request ", tc::as_dec(n * 1249), " "));
+		}
+		auto const ahocorasick = tc::make_aho_corasick(vecstrPattern);
+		benchmark("multi_search/40", "tc_aho_corasick", tc::size_raw(str), [&]() noexcept {
+			std::size_t nMatches = 0;
+			tc::for_each(tc::multi_search(str, ahocorasick), [&](tc::unused) noexcept { ++nMatches; });
+			return nMatches;
+		});
+		benchmark("multi_search/40", "tc_searcher", tc::size_raw(str), [&]() noexcept {
+			std::size_t nMatches = 0;
+			for( auto const& strPattern : vecstrPattern ) {
+				auto const searcher = tc::make_searcher(strPattern);
+				for( auto rng = tc::make_iterator_range(str.data(), str.data() + str.size()); auto const orng = tc::search_first<tc::return_view_or_none>(rng, searcher); ) {
+					++nMatches;
+					rng = tc::make_iterator_range(tc::end(*orng), tc::end(rng));
+				}
+			}
+			return nMatches;
+		});
+	}
+	void bench_enumset() noexcept {
+		// 240 permissions, combined from 64 roles of about 20 permissions each
+		using bignum_t = tc::integer<tc::enum_count<EPermission>::value>::unsigned_;
+		tc::vector<tc::enumset<EPermission>> vecsetepermission;
+		tc::vector<bignum_t> vecbignum;
+		auto const vecn = make_random_ints(64 * 20, tc::enum_count<EPermission>::value);
+		for( int nRole = 0; nRole < 64; ++nRole ) {
+			tc::enumset<EPermission> setepermission;
+			bignum_t bignum = 0;
+			for( int n = 0; n < 20; ++n ) {
+				auto const nPermission = vecn[nRole * 20 + n];
+				setepermission |= tc::contiguous_enum<EPermission>::begin() + nPermission;
+				bit_set(bignum, nPermission);
+			}
+			tc::cont_emplace_back(vecsetepermission, setepermission);
+			tc::cont_emplace_back(vecbignum, bignum);
+		}
+		auto const setepermissionMask = ~tc::enumset<EPermission>(tc::make_interval(epermissiona000, epermissionb000));
+		bignum_t const bignumMask = ~((bignum_t(1) << 64) - 1) & ((bignum_t(1) << tc::enum_count<EPermission>::value) - 1);
+
+		benchmark("enumset/240", "tc_word_array", 64, [&]() noexcept {
+			tc::enumset<EPermission> setepermission;
+			for( auto const& setepermissionRole : vecsetepermission ) setepermission |= setepermissionRole;
+			setepermission &= setepermissionMask;
+			std::size_t nSum = setepermission.size();
+			tc::for_each(setepermission, [&](auto const epermission) noexcept { nSum += epermission - epermissiona000; });
+			return nSum;
+		});
+		benchmark("enumset/240", "boost_multiprecision", 64, [&]() noexcept {
+			bignum_t bignum = 0;
+			for( auto const& bignumRole : vecbignum ) bignum |= bignumRole;
+			bignum &= bignumMask;
+			std::size_t nSum = 0;
+			for( bignum_t bignumRemaining = bignum; 0 != bignumRemaining; ) {
+				auto const nBit = boost::multiprecision::lsb(bignumRemaining);
+				bit_unset(bignumRemaining, nBit);
+				nSum += 1 + nBit;
+			}
+			return nSum;
+		});
+	}
+
+	void bench_packed_dense_map() noexcept {
+		// per-object permission flags: 240 bytes unpacked, 32 bytes packed
+		static constexpr int c_nObjects = 20000;
+		auto const vecn = make_random_ints(c_nObjects * 8, tc::enum_count<EPermission>::value);
+		tc::vector<tc::dense_map<EPermission, bool>> vecdm;
+		tc::vector<tc::packed_dense_map<EPermission, bool>> vecdmPacked;
+		for( int nObject = 0; nObject < c_nObjects; ++nObject ) {
+			tc::dense_map<EPermission, bool> dm(tc::fill_tag, false);
+			for( int n = 0; n < 8; ++n ) dm[tc::contiguous_enum<EPermission>::begin() + vecn[nObject * 8 + n]] = true;
+			tc::cont_emplace_back(vecdm, dm);
+			tc::cont_emplace_back(vecdmPacked, dm);
+		}
+		benchmark("dense_map/lookup", "tc_packed_dense_map", c_nObjects, [&]() noexcept {
+			std::size_t nCount = 0;
+			for( int nObject = 0; nObject < c_nObjects; ++nObject ) nCount += vecdmPacked[nObject][tc::contiguous_enum<EPermission>::begin() + vecn[nObject]];
+			return nCount;
+		});
+		benchmark("dense_map/lookup", "tc_dense_map", c_nObjects, [&]() noexcept {
+			std::size_t nCount = 0;
+			for( int nObject = 0; nObject < c_nObjects; ++nObject ) nCount += vecdm[nObject][tc::contiguous_enum<EPermission>::begin() + vecn[nObject]];
+			return nCount;
+		});
+	}
+
+	void bench_interval_set() noexcept {
+		// coverage of random reads
+		static constexpr int c_nIntervals = 200000;
+		auto const vecnLo = make_random_ints(c_nIntervals, 50000000);
+		auto const vecnLength = make_random_ints(c_nIntervals, 200);
+		auto const vecintvl = tc::make_vector(tc::transform(tc::iota(0, c_nIntervals), [&](int const n) noexcept {
+			return tc::make_interval(vecnLo[n], vecnLo[n] + vecnLength[n]);
+		}));
+		using intvlset_t = tc::interval_set<int, tc::interval<int>, tc::use_vector_impl_tag_t>;
+		benchmark("interval_set/build", "tc_range_tag", c_nIntervals, [&]() noexcept {
+			return intvlset_t(tc::range_tag, vecintvl).interval_count();
+		});
+		benchmark("interval_set/build", "tc_insert_each_set_impl", c_nIntervals, [&]() noexcept {
+			tc::interval_set<int> intvlset;
+			for( auto const& intvl : vecintvl ) intvlset |= intvl;
+			return intvlset.interval_count();
+		});
+
+		intvlset_t const intvlset(tc::range_tag, vecintvl);
+		intvlset_t const intvlsetSub(tc::range_tag, tc::transform(vecintvl, [](tc::interval<int> const& intvl) noexcept {
+			return tc::make_interval(intvl[tc::lo] + 100, intvl[tc::hi] + 150);
+		}));
+		benchmark("interval_set/subtract", "tc_merge", c_nIntervals, [&]() noexcept {
+			auto intvlsetDiff = intvlset;
+			intvlsetDiff -= intvlsetSub;
+			return intvlsetDiff.interval_count();
+		});
+		benchmark("interval_set/subtract", "tc_subtract_each_set_impl", c_nIntervals, [&]() noexcept {
+			tc::interval_set<int> intvlsetDiff(tc::range_tag, vecintvl);
+			tc::for_each(intvlsetSub, [&](tc::interval<int> const& intvl) noexcept { intvlsetDiff -= intvl; });
+			return intvlsetDiff.interval_count();
+		});
+
+		auto const vecnPoint = tc::make_vector(tc::transform(tc::iota(0, 1000000), [](int const n) noexcept { return n * 50; }));
+		benchmark("interval_set/contains", "tc_contains_each", tc::size_raw(vecnPoint), [&]() noexcept {
+			std::size_t nCount = 0;
+			tc::for_each(intvlset.contains_each(vecnPoint), [&](bool const b) noexcept { nCount += b; });
+			return nCount;
+		});
+		benchmark("interval_set/contains", "tc_contains", tc::size_raw(vecnPoint), [&]() noexcept {
+			std::size_t nCount = 0;
+			for( int const n : vecnPoint ) nCount += intvlset.contains(n);
+			return nCount;
+		});
+	}
+	void bench_interval_map() noexcept {
+		// annotations of a text, looked up by position
+		static constexpr int c_nIntervals = 20000;
+		auto const vecnLo = make_random_ints(c_nIntervals, 1000000);
+		auto const vecnLength = make_random_ints(c_nIntervals, 1000);
+		auto const vecpairintvln = tc::make_vector(tc::transform(tc::iota(0, c_nIntervals), [&](int const n) noexcept {
+			return std::make_pair(tc::make_interval(vecnLo[n], vecnLo[n] + vecnLength[n]), n);
+		}));
+		benchmark("interval_map/build", "tc_range_tag", c_nIntervals, [&]() noexcept {
+			return tc::interval_map<int, int>(tc::range_tag, vecpairintvln).size();
+		});
+
+		tc::interval_map<int, int> const intvlmap(tc::range_tag, vecpairintvln);
+		auto const vecnPoint = make_random_ints(10000, 1000000);
+		benchmark("interval_map/stab", "tc_interval_map", tc::size_raw(vecnPoint), [&]() noexcept {
+			int nSum = 0;
+			for( int const n : vecnPoint ) {
+				tc::for_each(intvlmap.containing(n), [&](auto const& pairintvln) noexcept { nSum += pairintvln.second; });
+			}
+			return nSum;
+		});
+		benchmark("interval_map/stab", "linear_scan", tc::size_raw(vecnPoint), [&]() noexcept {
+			int nSum = 0;
+			for( int const n : vecnPoint ) {
+				for( auto const& pairintvln : vecpairintvln ) {
+					if( pairintvln.first.contains(n) ) nSum += pairintvln.second;
+				}
+			}
+			return nSum;
+		});
+		benchmark("interval_map/overlap", "tc_interval_map", tc::size_raw(vecnPoint), [&]() noexcept {
+			int nSum = 0;
+			for( int const n : vecnPoint ) {
+				tc::for_each(intvlmap.overlapping(tc::make_interval(n, n + 100)), [&](auto const& pairintvln) noexcept { nSum += pairintvln.second; });
+			}
+			return nSum;
+		});
+	}
+	template<std::size_t n>
+	struct message final {
+		static constexpr int c_nWeight = n + 1;
+		int m_n;
+	};
+
+	template<std::size_t... n>
+	auto message_variant(std::index_sequence<n...>) -> std::variant<message<n>...>;
+
+	void bench_variant() noexcept {
+		// message dispatch over 40 alternatives, with messages of the same kind in bursts of 8
+		using message_t = decltype(message_variant(std::make_index_sequence<40>()));
+		auto const vecnAlternative = make_random_ints(100000 / 8, 40);
+		auto const vecmessage = tc::make_vector(tc::transform(tc::iota(0, 100000), [&](int const n) noexcept {
+			return tc::invoke_with_constant<std::make_index_sequence<40>>([&](auto constn) noexcept {
+				return message_t(std::in_place_index<decltype(constn)::value>, message<decltype(constn)::value>{n});
+			}, tc::explicit_cast<std::size_t>(vecnAlternative[n / 8]));
+		}));
+		auto const Handle = [](auto const& msg) noexcept { return msg.m_n * msg.c_nWeight; };
+		benchmark("variant/visit40", "tc_fn_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( auto const& msg : vecmessage ) nSum += tc::fn_visit(Handle)(msg);
+			return nSum;
+		});
+		benchmark("variant/visit40", "std_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( auto const& msg : vecmessage ) nSum += std::visit(Handle, msg);
+			return nSum;
+		});
+
+		// the same handler for all alternatives, e.g., reading a common header, which the switch lets the compiler merge
+		auto const HandleCommon = [](auto const& msg) noexcept { return msg.m_n; };
+		benchmark("variant/visit40_common", "tc_fn_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( auto const& msg : vecmessage ) nSum += tc::fn_visit(HandleCommon)(msg);
+			return nSum;
+		});
+		benchmark("variant/visit40_common", "std_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( auto const& msg : vecmessage ) nSum += std::visit(HandleCommon, msg);
+			return nSum;
+		});
+
+		// pairs of variants
+		auto const vecmessageOther = tc::make_vector(tc::reverse(vecmessage));
+		auto const HandlePair = [](auto const& msgA, auto const& msgB) noexcept { return msgA.m_n - msgB.m_n; };
+		benchmark("variant/visit40x40", "tc_fn_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( std::size_t n = 0; n < tc::size_raw(vecmessage); ++n ) nSum += tc::fn_visit(HandlePair)(vecmessage[n], vecmessageOther[n]);
+			return nSum;
+		});
+		benchmark("variant/visit40x40", "std_visit", tc::size_raw(vecmessage), [&]() noexcept {
+			int nSum = 0;
+			for( std::size_t n = 0; n < tc::size_raw(vecmessage); ++n ) nSum += std::visit(HandlePair, vecmessage[n], vecmessageOther[n]);
+			return nSum;
+		});
+	}
+}
+
+int main(int nArgs, char* aszArgs[]) {
+	for( int nArg = 1; nArg < nArgs; ++nArg ) {
+		auto const ParseArg = [&](char const* szPrefix) noexcept -> char const* {
+			auto const nPrefix = std::strlen(szPrefix);
+			return 0 == std::strncmp(aszArgs[nArg], szPrefix, nPrefix) ? aszArgs[nArg] + nPrefix : nullptr;
+		};
+		if( auto const sz = ParseArg("--filter=") ) {
+			g_options.m_strFilter = sz;
+		} else if( auto const sz = ParseArg("--min_time=") ) {
+			g_options.m_dMinTime = std::atof(sz);
+		} else if( auto const sz = ParseArg("--json=") ) {
+			g_options.m_strJson = sz;
+		} else {
+			std::fprintf(stderr, "usage: range_bench [--filter=<substring>] [--min_time=<seconds>] [--json=<file>]\n");
+			return 1;
+		}
+	}
+
+	bench_adaptors();
+	bench_append();
+	bench_sort_streaming();
+	bench_merge_many();
+	bench_convert_enc();
+	bench_format();
+	bench_from_string();
+	bench_deserialize();
+	bench_search();
+	bench_enumset();
+	bench_packed_dense_map();
+	bench_interval_set();
+	bench_interval_map();
+	bench_variant();
+	write_json();
+	return 0;
+}
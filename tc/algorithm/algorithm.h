@@ -234,6 +234,14 @@ namespace tc {
 
 			template<typename LessOrComp>
 			explicit sorted_index_adaptor(Rng&& rng, LessOrComp lessorcomp) noexcept
+				: sorted_index_adaptor(std::forward<Rng>(rng), tc_move(lessorcomp), [](auto& vecidx, auto const& less) noexcept {
+					tc::sort_inplace(vecidx, less);
+				})
+			{}
+
+			// sortinplace(m_vecidx, less) sorts the indices, e.g., in parallel.
+			template<typename LessOrComp, typename SortInplace>
+			explicit sorted_index_adaptor(Rng&& rng, LessOrComp lessorcomp, SortInplace sortinplace) noexcept
 				: tc::range_adaptor_base_range<Rng>(tc::aggregate_tag, std::forward<Rng>(rng))
 			{
 				if constexpr (tc::has_size<Rng>) {
@@ -242,7 +250,7 @@ namespace tc {
 				for(auto idx=this->base_begin_index(); !tc::at_end_index(this->base_range(), idx); tc::increment_index(this->base_range(), idx)) {
 					tc::cont_emplace_back(m_vecidx, idx);
 				}
-				tc::sort_inplace(
+				sortinplace(
 					m_vecidx,
 					[&](auto const& idxLhs, auto const& idxRhs ) noexcept -> bool {
 						tc_auto_cref(lhs, tc::dereference_index(this->base_range(), idxLhs));
@@ -356,6 +356,39 @@ UNITTESTDEF(sort_test) {
 	_ASSERT(tc::equal(rngpairnnSorted, vecpairnn2));
 }
 
+UNITTESTDEF(find_first_vectorized) {
+	enum class ETest : std::uint16_t { a, b };
+	auto Test = [](auto const t, auto const tOther) noexcept {
+		using T = tc::decay_t<decltype(t)>;
+		static_assert(tc::find_first_equal_detail::vectorizable<tc::vector<T>&, T const&>);
+		for( int nSize = 0; nSize < 70; ++nSize ) {
+			tc::vector<T> vec(nSize, tOther);
+			_ASSERT(!tc::find_first<tc::return_bool>(vec, t));
+			_ASSERT(!tc::find_first<tc::return_element_or_null>(vec, t));
+			for( int n = 0; n < nSize; ++n ) {
+				vec[n] = t;
+				_ASSERTEQUAL(tc::find_unique<tc::return_element_index>(vec, t), n);
+				_ASSERTEQUAL(tc::find_first<tc::return_element_or_null>(tc::as_const(vec), t), tc::begin(tc::as_const(vec)) + n);
+				_ASSERTEQUAL(tc::find_first<tc::return_element_index>(tc::begin_next<tc::return_drop>(vec, n), t), 0);
+				vec[n] = tOther;
+			}
+		}
+	};
+	Test('x', 'y');
+	Test(static_cast<unsigned char>(0x80), static_cast<unsigned char>(0x7f));
+	Test(ETest::b, ETest::a);
+	Test(-1, 0x7fffffff);
+	Test(std::int64_t(1) << 32, std::int64_t(1));
+	Test(std::uint64_t(1), std::uint64_t(1) << 32);
+
+	tc::vector<int> vecn{1, 2, 3, 2};
+	_ASSERTEQUAL(tc::find_first<tc::return_element_index>(vecn, 2), 1);
+	_ASSERTEQUAL(tc::size(tc::find_first<tc::return_take_before>(vecn, 3)), 2);
+	_ASSERTEQUAL(tc::find_first<tc::return_border_after_or_end>(vecn, 4), tc::end(vecn));
+	_ASSERT(!tc::find_first<tc::return_bool>("abc", 'd'));
+	_ASSERT(tc::find_first<tc::return_bool>(tc::string<char>("abc"), 'c'));
+}
+
 #ifdef __clang__ // remove if std::sort is constexpr in xcode
 UNITTESTDEF(constexpr_sort_test) {
 	std::mt19937 gen; // same sequence of numbers each time for reproducibility
@@ -197,6 +197,17 @@ namespace tc {
  			tc::append(cont, std::forward<Rng0>(rng0), std::forward<RngN>(rngN)...);
 			return cont;
 		}
+
+		// tc::explicit_cast<Cont>(std::allocator_arg, alloc, rng...) constructs Cont with allocator alloc.
+		template<appendable_container TTarget, typename Alloc, tc::appendable<TTarget&>... Rng>
+			requires std::constructible_from<TTarget, Alloc const&>
+		constexpr TTarget explicit_convert_impl(adl_tag_t, tc::type::identity<TTarget>, std::allocator_arg_t, Alloc const& alloc, Rng&&... rng) MAYTHROW {
+			TTarget cont(alloc);
+			if constexpr( 0 < sizeof...(Rng) ) {
+				tc::append(cont, std::forward<Rng>(rng)...);
+			}
+			return cont;
+		}
 	}
 
 	template< typename... Rng >
@@ -205,6 +216,14 @@ namespace tc {
 		return tc::explicit_cast<tc::vector<tc::range_value_t<decltype(tc::concat(std::forward<Rng>(rng)...))>>>(std::forward<Rng>(rng)...);
 	}
 
+	// Allocates the vector, e.g., from a tc::monotonic_arena, with alloc rebound to the value type.
+	template< typename Alloc, typename... Rng > requires tc::allocator<std::remove_cvref_t<Alloc>>
+	[[nodiscard]] auto make_vector(Alloc&& alloc, Rng&&... rng) MAYTHROW {
+		static_assert(0 < sizeof...(Rng));
+		using T = tc::range_value_t<decltype(tc::concat(std::forward<Rng>(rng)...))>;
+		return tc::explicit_cast<tc::vector<T, typename std::allocator_traits<std::remove_cvref_t<Alloc>>::template rebind_alloc<T>>>(std::allocator_arg, alloc, std::forward<Rng>(rng)...);
+	}
+
 	template< typename Char, typename... Rng >
 	[[nodiscard]] auto make_str(Rng&&... rng) MAYTHROW {
 		static_assert(0 < sizeof...(Rng));
@@ -12,6 +12,8 @@
 #include "../range/meta.h"
 #include "../range/iterator_cache.h"
 #include "../base/scope.h"
+#include "../base/simd.h"
+#include "../range/subrange.h"
 #include "../storage_for.h"
 
 #include "equal.h"
@@ -82,6 +84,34 @@ namespace tc {
 		}
 	}
 
+	namespace find_first_equal_detail {
+		// Equality search on contiguous ranges of bitwise comparable elements is vectorized.
+		template<typename Rng, typename T>
+		concept vectorizable =
+			tc::contiguous_range<Rng> &&
+			tc::simd::bitwise_comparable<tc::range_value_t<Rng>> &&
+			std::is_same<tc::range_value_t<Rng>, std::remove_cvref_t<T>>::value;
+
+		template< typename RangeReturn, IF_TC_CHECKS(bool c_bCheckUnique,) typename Rng >
+		[[nodiscard]] tc::element_return_type_t<RangeReturn, Rng> find_first_equal(Rng&& rng, tc::range_value_t<Rng> const t) noexcept {
+			auto const pBegin = tc::ptr_begin(rng);
+			auto const pEnd = tc::ptr_end(rng);
+			auto const pFound = tc::simd::find_first_equal<tc::range_value_t<Rng>>(pBegin, pEnd, t);
+			if( pEnd == pFound ) {
+				return RangeReturn::pack_no_element(std::forward<Rng>(rng));
+			} else {
+#ifdef _CHECKS
+				if constexpr( c_bCheckUnique ) {
+					_ASSERTE( pEnd == tc::simd::find_first_equal<tc::range_value_t<Rng>>(pFound + 1, pEnd, t) );
+				}
+#endif
+				auto it = tc::begin(rng) + (pFound - pBegin);
+				decltype(auto) ref = *it;
+				return RangeReturn::pack_element(tc_move(it), std::forward<Rng>(rng), tc_move_if_owned(ref));
+			}
+		}
+	}
+
 	template< typename RangeReturn, typename Rng, typename Pred = tc::identity >
 	[[nodiscard]] constexpr decltype(auto) find_first_if(Rng&& rng, Pred&& pred = Pred()) MAYTHROW {
 		return find_first_if_detail::find_first_if<RangeReturn IF_TC_CHECKS(, /*c_bCheckUnique*/false)>(std::forward<Rng>(rng), std::forward<Pred>(pred));
@@ -144,6 +174,11 @@ namespace tc {
 				!tc::has_key_type<std::remove_cvref_t<Rng>>::value,
 				"Do you want to use tc::cont_find?"
 			);
+			if constexpr( find_first_equal_detail::vectorizable<Rng, T> ) {
+				if( !std::is_constant_evaluated() ) {
+					return find_first_equal_detail::find_first_equal<RangeReturn IF_TC_CHECKS(, c_bCheckUnique)>(std::forward<Rng>(rng), t);
+				}
+			}
 			return find_first_if_detail::find_first_if<RangeReturn IF_TC_CHECKS(, c_bCheckUnique)>(std::forward<Rng>(rng), [&](auto const& _) MAYTHROW { return tc::equal_to(_, t); });
 		}
 	}
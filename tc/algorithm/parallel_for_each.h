@@ -0,0 +1,103 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/assign.h"
+#include "../thread_pool.h"
+
+#include "for_each.h"
+#include "size.h"
+
+#include <atomic>
+
+namespace tc {
+	namespace parallel_for_each_detail {
+		// Begin of chunk nChunk when splitting nSize elements into nChunks chunks of almost equal size.
+		[[nodiscard]] constexpr std::size_t chunk_begin(std::size_t const nSize, std::size_t const nChunks, std::size_t const nChunk) noexcept {
+			_ASSERTDEBUG(nChunk <= nChunks);
+			return nSize / nChunks * nChunk + tc::min(nChunk, nSize % nChunks);
+		}
+
+		template<typename Rng, typename Sink>
+		using sink_result_t = decltype(tc::continue_if_not_break(std::declval<tc::decay_t<Sink> const&>(), *tc::as_lvalue(tc::begin(std::declval<Rng&>()))));
+
+		template<typename Rng, typename Sink>
+		concept parallelizable =
+			tc::random_access_range<Rng> &&
+			tc::common_range<Rng> &&
+			!std::is_same<sink_result_t<Rng, Sink>, tc::constant<tc::break_>>::value;
+	}
+
+	// Parallel for_each over random-access ranges: the range is split into chunks, which are processed on the thread pool of the policy.
+	// - sink is called concurrently from different threads.
+	// - Elements within a chunk are passed to sink in order, but there is no order between chunks.
+	// - If sink returns break_, all elements before the breaking element have been passed to sink when for_each returns. Chunks
+	//   after the breaking element are cancelled cooperatively, but some of their elements may have been passed to sink already.
+	// - If sink throws, the exception of the earliest element is rethrown after all running chunks have finished, unless sink
+	//   returned break_ for an earlier element.
+	// Other ranges are processed sequentially.
+	template<typename Rng, typename Sink> requires parallel_for_each_detail::parallelizable<Rng, Sink>
+	auto for_each(tc::par_t const& par, Rng&& rng, Sink&& sink_) MAYTHROW -> tc::common_type_t<parallel_for_each_detail::sink_result_t<Rng, Sink>, tc::constant<tc::continue_>> {
+		using sink_result_t = parallel_for_each_detail::sink_result_t<Rng, Sink>;
+		tc::decay_t<Sink> const sink = sink_;
+
+		auto const itBegin = tc::begin(rng);
+		auto const nSize = tc::explicit_cast<std::size_t>(tc::end(rng) - itBegin);
+		auto const nChunks = par.chunk_count(nSize);
+		std::atomic<std::size_t> nChunkStop(nChunks); // earliest chunk which returned break_ or threw, later chunks are cancelled
+		std::atomic<std::size_t> nChunkBreak(nChunks); // earliest chunk which returned break_
+		auto const ProcessChunk = [&](std::size_t const nChunk) MAYTHROW {
+			auto const itEnd = itBegin + parallel_for_each_detail::chunk_begin(nSize, nChunks, nChunk + 1);
+			for( auto it = itBegin + parallel_for_each_detail::chunk_begin(nSize, nChunks, nChunk); it != itEnd; ++it ) {
+				if constexpr( std::is_same<sink_result_t, tc::constant<tc::continue_>>::value ) {
+					tc::continue_if_not_break(sink, *it); // MAYTHROW
+				} else {
+					if( nChunkStop.load(std::memory_order_relaxed) < nChunk ) return; // cancelled by an earlier chunk
+					try {
+						if( tc::break_ == tc::continue_if_not_break(sink, *it) ) { // MAYTHROW
+							tc::assign_min(nChunkBreak, nChunk);
+							tc::assign_min(nChunkStop, nChunk);
+							return;
+						}
+					} catch (...) {
+						tc::assign_min(nChunkStop, nChunk);
+						throw;
+					}
+				}
+			}
+		};
+
+		auto const ProcessChunks = [&]() MAYTHROW {
+			if( 1 == nChunks ) {
+				ProcessChunk(0); // MAYTHROW
+			} else {
+				par.pool().run_and_wait(nChunks, ProcessChunk); // MAYTHROW
+			}
+		};
+
+		if constexpr( std::is_same<sink_result_t, tc::constant<tc::continue_>>::value ) {
+			ProcessChunks(); // MAYTHROW
+			return tc::constant<tc::continue_>();
+		} else {
+			try {
+				ProcessChunks(); // MAYTHROW
+			} catch (...) {
+				// The exception is the one of the earliest throwing chunk. If an earlier chunk returned break_, it stopped first,
+				// and a sequential loop would never have reached the throwing element.
+				if( nChunkBreak.load() != nChunkStop.load() ) throw;
+			}
+			return tc::continue_if(nChunks == nChunkBreak.load());
+		}
+	}
+
+	template<typename Rng, typename Sink> requires (!parallel_for_each_detail::parallelizable<Rng, Sink>)
+	constexpr auto for_each(tc::par_t const&, Rng&& rng, Sink&& sink) return_MAYTHROW(
+		tc::for_each(std::forward<Rng>(rng), std::forward<Sink>(sink))
+	)
+}
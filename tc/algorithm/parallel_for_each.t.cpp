@@ -0,0 +1,75 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "parallel_for_each.h"
+#include "quantifier.h"
+
+#include <stdexcept>
+
+UNITTESTDEF(parallel_for_each) {
+	tc::thread_pool threadpool(3);
+	auto const par = tc::par.on(threadpool).min_chunk_size(100);
+
+	tc::vector<int> vecn(10000);
+	STATICASSERTSAME((decltype(tc::for_each(par, vecn, [](int& n) noexcept { ++n; }))), (tc::constant<tc::continue_>));
+	tc::for_each(par, vecn, [](int& n) noexcept { ++n; });
+	_ASSERT(tc::all_of(vecn, [](int const n) noexcept { return 1 == n; }));
+
+	std::atomic<long long> nSum(0);
+	tc::for_each(par, tc::iota(0, 10000), [&](int const n) noexcept { nSum += n; });
+	_ASSERTEQUAL(nSum.load(), 10000ll * 9999 / 2);
+
+	// all elements before the breaking element are visited
+	tc::vector<std::atomic<bool>> vecbVisited(10000);
+	_ASSERTEQUAL(tc::break_, tc::for_each(par, tc::iota(0, 10000), [&](int const n) noexcept {
+		vecbVisited[n] = true;
+		return tc::continue_if(n != 5000);
+	}));
+	for( int n = 0; n <= 5000; ++n ) _ASSERT(vecbVisited[n]);
+	_ASSERTEQUAL(tc::continue_, tc::for_each(par, tc::iota(0, 10000), [&](int) noexcept { return tc::continue_; }));
+
+	// the exception of the earliest element is rethrown
+	try {
+		tc::for_each(par, tc::iota(0, 10000), [&](int const n) MAYTHROW {
+			if( 3000 == n || 8000 == n ) throw std::runtime_error(std::to_string(n));
+		});
+		_ASSERTFALSE;
+	} catch (std::runtime_error const& e) {
+		_ASSERTEQUAL(std::string(e.what()), "3000");
+	}
+
+	// exceptions after the breaking element are dropped, as a sequential loop would never have reached them
+	for( int nRun = 0; nRun < 20; ++nRun ) {
+		std::atomic<bool> bBroken(false);
+		_ASSERTEQUAL(tc::break_, tc::for_each(par, tc::iota(0, 10000), [&](int const n) MAYTHROW {
+			if( 9000 == n ) {
+				while( !bBroken ) {} // throw only after the earlier chunk has returned break_
+				throw std::runtime_error(std::to_string(n));
+			}
+			if( 100 == n ) {
+				bBroken = true;
+				return tc::break_;
+			}
+			return tc::continue_;
+		}));
+	}
+
+	// nested parallel loops do not deadlock
+	nSum = 0;
+	tc::for_each(par, tc::iota(0, 1000), [&](int) noexcept {
+		tc::for_each(tc::par.on(threadpool).min_chunk_size(10), tc::iota(0, 100), [&](int const n) noexcept { nSum += n; });
+	});
+	_ASSERTEQUAL(nSum.load(), 1000ll * 100 * 99 / 2);
+
+	// sequential fallback for ranges without random access
+	int nCount = 0;
+	tc::for_each(par, tc::make_generator_range(vecn), [&](int) noexcept { ++nCount; });
+	_ASSERTEQUAL(nCount, 10000);
+}
@@ -0,0 +1,264 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/noncopyable.h"
+#include "../thread_pool.h"
+
+#include "algorithm.h"
+#include "parallel_for_each.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+namespace tc {
+	namespace parallel_sort_detail {
+		// Calls func(nChunk, nBegin, nEnd) for the nChunks chunks of [0, nSize) concurrently.
+		template<typename Func>
+		void for_each_chunk(tc::par_t const& par, std::size_t const nSize, std::size_t const nChunks, Func func) noexcept {
+			NOEXCEPT(par.pool().run_and_wait(nChunks, [&](std::size_t const nChunk) noexcept {
+				func(nChunk, parallel_for_each_detail::chunk_begin(nSize, nChunks, nChunk), parallel_for_each_detail::chunk_begin(nSize, nChunks, nChunk + 1));
+			}));
+		}
+
+		// Uninitialized memory, filled by moving the elements of a range in parallel.
+		template<typename T>
+		struct [[nodiscard]] buffer final : tc::nonmovable {
+			template<typename It>
+			buffer(tc::par_t const& par, It const itBegin, std::size_t const nSize, std::size_t const nChunks) noexcept
+				: m_pt(NOBADALLOC(std::allocator<T>().allocate(nSize)))
+				, m_nSize(nSize)
+			{
+				for_each_chunk(par, nSize, nChunks, [&](std::size_t, std::size_t const nBegin, std::size_t const nEnd) noexcept {
+					std::uninitialized_move(itBegin + nBegin, itBegin + nEnd, m_pt + nBegin);
+				});
+			}
+
+			~buffer() {
+				std::destroy(m_pt, m_pt + m_nSize);
+				std::allocator<T>().deallocate(m_pt, m_nSize);
+			}
+
+			T* const m_pt;
+			std::size_t const m_nSize;
+		};
+
+		// Number of elements of the stable merge of [pA, pA+nA) and [pB, pB+nB) which come from A among the first n.
+		template<typename T, typename Less>
+		[[nodiscard]] std::size_t merge_split(T const* const pA, std::size_t const nA, T const* const pB, std::size_t const nB, std::size_t const n, Less const& less) noexcept {
+			auto nLow = nB < n ? n - nB : 0;
+			auto nHigh = tc::min(n, nA);
+			while( nLow < nHigh ) {
+				auto const i = nLow + (nHigh - nLow) / 2;
+				// On ties, A comes first: if B[n-i-1] is not less than A[i], A[i] belongs to the first n.
+				if( !less(pB[n - i - 1], pA[i]) ) {
+					nLow = i + 1;
+				} else {
+					nHigh = i;
+				}
+			}
+			return nLow;
+		}
+
+		// Sample sort: the elements are distributed into buckets delimited by splitters, which are chosen from a sorted sample.
+		// Elements equal to a splitter go to an equality bucket, which needs no sorting, so many equal keys do not hurt
+		// load balance. The other buckets are sorted concurrently.
+		template<typename It, typename Less>
+		void sample_sort(tc::par_t const& par, It const itBegin, std::size_t const nSize, std::size_t const nChunks, Less const& less) noexcept {
+			using value_type = std::iter_value_t<It>;
+			buffer<value_type> buf(par, itBegin, nSize, nChunks);
+
+			// Oversampling makes the buckets similar in size. Splitters point into the buffer, which is not modified until
+			// all elements have been classified.
+			static constexpr std::size_t c_nOversampling = 16;
+			auto const nSamples = tc::min(nChunks * c_nOversampling, nSize);
+			tc::vector<value_type const*> vecpSample;
+			tc::cont_reserve(vecpSample, nSamples);
+			auto const nStride = nSize / nSamples;
+			std::uint32_t nRandom = 4711;
+			for( std::size_t nSample = 0; nSample < nSamples; ++nSample ) {
+				nRandom = nRandom * 1664525u + 1013904223u;
+				tc::cont_emplace_back(vecpSample, buf.m_pt + nSample * nStride + nRandom % nStride);
+			}
+			tc::sort_inplace(vecpSample, [&](value_type const* const plhs, value_type const* const prhs) noexcept { return less(*plhs, *prhs); });
+			tc::vector<value_type const*> vecpSplitter;
+			for( std::size_t nSplitter = 1; nSplitter < nChunks; ++nSplitter ) {
+				auto const pSplitter = vecpSample[nSplitter * nSamples / nChunks];
+				if( tc::empty(vecpSplitter) || less(*tc::back(vecpSplitter), *pSplitter) ) {
+					tc::cont_emplace_back(vecpSplitter, pSplitter);
+				}
+			}
+
+			// Bucket 2*i holds the elements between splitters i-1 and i, bucket 2*i+1 the elements equal to splitter i.
+			std::size_t const nBuckets = 2 * tc::size_raw(vecpSplitter) + 1;
+			auto const Bucket = [&](value_type const& t) noexcept -> std::size_t {
+				auto const itSplitter = std::upper_bound(tc::begin(vecpSplitter), tc::end(vecpSplitter), std::addressof(t), [&](value_type const* const plhs, value_type const* const prhs) noexcept {
+					return less(*plhs, *prhs);
+				});
+				auto const nSplitter = tc::explicit_cast<std::size_t>(itSplitter - tc::begin(vecpSplitter));
+				if( 0 < nSplitter && !less(*vecpSplitter[nSplitter - 1], t) ) {
+					return 2 * nSplitter - 1;
+				} else {
+					return 2 * nSplitter;
+				}
+			};
+
+			// Each chunk counts its elements per bucket, then moves them to the bucket positions reserved for it. Moving
+			// invalidates the splitters, so the buckets are remembered.
+			tc::vector<std::size_t> vecnOffset(nChunks * nBuckets);
+			tc::vector<std::uint32_t> vecnBucket(nSize);
+			for_each_chunk(par, nSize, nChunks, [&](std::size_t const nChunk, std::size_t const nBegin, std::size_t const nEnd) noexcept {
+				auto const itnCount = tc::begin(vecnOffset) + nChunk * nBuckets;
+				for( auto n = nBegin; n != nEnd; ++n ) {
+					auto const nBucket = Bucket(buf.m_pt[n]);
+					vecnBucket[n] = static_cast<std::uint32_t>(nBucket);
+					++itnCount[nBucket];
+				}
+			});
+			tc::vector<std::size_t> vecnBucketBegin(nBuckets + 1);
+			{
+				std::size_t nOffset = 0;
+				for( std::size_t nBucket = 0; nBucket < nBuckets; ++nBucket ) {
+					vecnBucketBegin[nBucket] = nOffset;
+					for( std::size_t nChunk = 0; nChunk < nChunks; ++nChunk ) {
+						nOffset += std::exchange(vecnOffset[nChunk * nBuckets + nBucket], nOffset);
+					}
+				}
+				_ASSERTEQUAL(nOffset, nSize);
+				tc::back(vecnBucketBegin) = nSize;
+			}
+			for_each_chunk(par, nSize, nChunks, [&](std::size_t const nChunk, std::size_t const nBegin, std::size_t const nEnd) noexcept {
+				auto const itnOffset = tc::begin(vecnOffset) + nChunk * nBuckets;
+				for( auto n = nBegin; n != nEnd; ++n ) {
+					*(itBegin + itnOffset[vecnBucket[n]]++) = tc_move_always(buf.m_pt[n]);
+				}
+			});
+
+			NOEXCEPT(par.pool().run_and_wait(nBuckets / 2 + 1, [&](std::size_t const nTask) noexcept {
+				std::sort(itBegin + vecnBucketBegin[2 * nTask], itBegin + vecnBucketBegin[2 * nTask + 1], less);
+			}));
+		}
+
+		// Merge sort: the chunks are stable-sorted concurrently, then pairs of runs are merged in rounds, alternating between
+		// the range and a buffer. Each merge is split into pieces of similar size, so the last rounds use all threads as well.
+		template<typename It, typename Less>
+		void merge_sort(tc::par_t const& par, It const itBegin, std::size_t const nSize, std::size_t const nChunks, Less const& less) noexcept {
+			using value_type = std::iter_value_t<It>;
+			for_each_chunk(par, nSize, nChunks, [&](std::size_t, std::size_t const nBegin, std::size_t const nEnd) noexcept {
+				std::stable_sort(itBegin + nBegin, itBegin + nEnd, less);
+			});
+			buffer<value_type> buf(par, itBegin, nSize, nChunks);
+
+			tc::vector<std::size_t> vecnRunBegin;
+			for( std::size_t nChunk = 0; nChunk <= nChunks; ++nChunk ) {
+				tc::cont_emplace_back(vecnRunBegin, parallel_for_each_detail::chunk_begin(nSize, nChunks, nChunk));
+			}
+			value_type* const pBuffer = buf.m_pt;
+			value_type* const pRange = std::addressof(*itBegin);
+			value_type* pSource = pBuffer;
+			value_type* pTarget = pRange;
+			while( 2 < tc::size(vecnRunBegin) ) {
+				auto const nPairs = tc::size(vecnRunBegin) / 2; // an odd run is merged with an empty run
+				auto const nPieces = tc::max(nChunks / nPairs, std::size_t(1));
+				NOEXCEPT(par.pool().run_and_wait(nPairs * nPieces, [&](std::size_t const nTask) noexcept {
+					auto const nPair = nTask / nPieces;
+					auto const nPiece = nTask % nPieces;
+					auto const nBegin = vecnRunBegin[2 * nPair];
+					auto const nMiddle = vecnRunBegin[tc::min(2 * nPair + 1, tc::size(vecnRunBegin) - 1)];
+					auto const nEnd = vecnRunBegin[tc::min(2 * nPair + 2, tc::size(vecnRunBegin) - 1)];
+					auto const nFirst = (nEnd - nBegin) * nPiece / nPieces;
+					auto const nLast = (nEnd - nBegin) * (nPiece + 1) / nPieces;
+					auto const pA = pSource + nBegin;
+					auto const pB = pSource + nMiddle;
+					auto const nA0 = merge_split(pA, nMiddle - nBegin, pB, nEnd - nMiddle, nFirst, less);
+					auto const nA1 = merge_split(pA, nMiddle - nBegin, pB, nEnd - nMiddle, nLast, less);
+					std::merge(
+						std::make_move_iterator(pA + nA0), std::make_move_iterator(pA + nA1),
+						std::make_move_iterator(pB + (nFirst - nA0)), std::make_move_iterator(pB + (nLast - nA1)),
+						pTarget + nBegin + nFirst,
+						less
+					);
+				}));
+				tc::vector<std::size_t> vecnRunBeginMerged;
+				for( std::size_t nRun = 0; nRun < tc::size(vecnRunBegin); nRun += 2 ) {
+					tc::cont_emplace_back(vecnRunBeginMerged, vecnRunBegin[nRun]);
+				}
+				if( tc::back(vecnRunBeginMerged) != nSize ) tc::cont_emplace_back(vecnRunBeginMerged, nSize);
+				vecnRunBegin = tc_move(vecnRunBeginMerged);
+				std::swap(pSource, pTarget);
+			}
+			if( pSource != pRange ) {
+				for_each_chunk(par, nSize, nChunks, [&](std::size_t, std::size_t const nBegin, std::size_t const nEnd) noexcept {
+					std::move(pSource + nBegin, pSource + nEnd, pRange + nBegin);
+				});
+			}
+		}
+
+		template<typename Rng>
+		concept parallel_sortable =
+			tc::random_access_range<Rng> &&
+			tc::common_range<Rng> &&
+			!has_mem_fn_sort<Rng>;
+	}
+
+	// Parallel sorts on the thread pool of the policy. Ranges smaller than the minimum chunk size of the policy, which are not
+	// worth a task, and ranges without random access are sorted sequentially. less is called concurrently from different threads.
+	template<typename Rng, typename Less = tc::fn_less>
+	void sort_inplace(tc::par_t const par, Rng&& rng, Less&& less = Less()) noexcept {
+		if constexpr( parallel_sort_detail::parallel_sortable<Rng> ) {
+			auto const nSize = tc::explicit_cast<std::size_t>(tc::size(rng));
+			if( auto const nChunks = par.chunk_count(nSize); 1 < nChunks ) {
+				parallel_sort_detail::sample_sort(par, tc::begin(rng), nSize, nChunks, less);
+				return;
+			}
+		}
+		tc::sort_inplace(std::forward<Rng>(rng), std::forward<Less>(less));
+	}
+
+	template<typename Rng, typename Less = tc::fn_less>
+	void stable_sort_inplace(tc::par_t const par, Rng&& rng, Less&& less = Less()) noexcept {
+		if constexpr( parallel_sort_detail::parallel_sortable<Rng> && tc::contiguous_range<Rng> ) {
+			auto const nSize = tc::explicit_cast<std::size_t>(tc::size(rng));
+			if( auto const nChunks = par.chunk_count(nSize); 1 < nChunks ) {
+				parallel_sort_detail::merge_sort(par, tc::begin(rng), nSize, nChunks, less);
+				return;
+			}
+		}
+		tc::stable_sort_inplace(std::forward<Rng>(rng), std::forward<Less>(less));
+	}
+
+	template< typename Cont, typename Less=tc::fn_less >
+	void sort_unique_inplace(tc::par_t const par, Cont& cont, Less less=Less()) noexcept {
+		tc::sort_inplace( par, cont, less );
+		tc::ordered_unique_inplace( cont, tc_move(less) );
+	}
+
+	template< typename Cont, typename Less=tc::fn_less >
+	void stable_sort_unique_inplace(tc::par_t const par, Cont& cont, Less less=Less()) noexcept {
+		tc::stable_sort_inplace( par, cont, less );
+		tc::ordered_unique_inplace( cont, tc_move(less) );
+	}
+
+	// The sorted index vector is sorted in parallel, the elements are not moved.
+	template<typename Rng, typename Less = tc::fn_less>
+	[[nodiscard]] auto sort(tc::par_t const par, Rng&& rng, Less&& less = Less()) noexcept {
+		return tc::sorted_index_adaptor<Rng, false/*bStable*/>(std::forward<Rng>(rng), std::forward<Less>(less), [&](auto& vecidx, auto const& lessIndex) noexcept {
+			tc::sort_inplace(par, vecidx, lessIndex);
+		});
+	}
+
+	template<typename Rng, typename Comp = tc::fn_compare>
+	[[nodiscard]] auto stable_sort(tc::par_t const par, Rng&& rng, Comp&& comp = Comp()) noexcept {
+		// The index comparison of the stable sorted_index_adaptor breaks ties, so an unstable sort of the indices suffices.
+		return tc::sorted_index_adaptor<Rng, true/*bStable*/>(std::forward<Rng>(rng), std::forward<Comp>(comp), [&](auto& vecidx, auto const& lessIndex) noexcept {
+			tc::sort_inplace(par, vecidx, lessIndex);
+		});
+	}
+}
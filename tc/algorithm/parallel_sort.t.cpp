@@ -0,0 +1,81 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "../range/transform.h"
+#include "../string/format.h"
+#include "equal.h"
+#include "parallel_sort.h"
+
+namespace {
+	tc::vector<int> random_ints(std::size_t const nSize, int const nMax) noexcept {
+		unsigned int nState = 4711;
+		tc::vector<int> vecn;
+		for( std::size_t n = 0; n < nSize; ++n ) {
+			nState = nState * 1103515245u + 12345u;
+			tc::cont_emplace_back(vecn, static_cast<int>((nState >> 8) % nMax));
+		}
+		return vecn;
+	}
+}
+
+UNITTESTDEF(parallel_sort_inplace) {
+	tc::thread_pool threadpool(3);
+	auto const par = tc::par.on(threadpool).min_chunk_size(100);
+
+	for( int const nMax : {1, 2, 50, 1 << 30} ) { // many equal keys, few equal keys
+		for( std::size_t const nSize : {0, 1, 99, 100, 1000, 12345} ) {
+			auto vecn = random_ints(nSize, nMax);
+			auto vecnExpected = vecn;
+			tc::sort_inplace(vecnExpected);
+			tc::sort_inplace(par, vecn);
+			_ASSERT(tc::equal(vecn, vecnExpected));
+
+			tc::sort_inplace(par, vecn, tc::fn_greater());
+			_ASSERT(tc::equal(vecn, tc::reverse(vecnExpected)));
+
+			tc::sort_unique_inplace(par, vecn);
+			tc::sort_unique_inplace(vecnExpected);
+			_ASSERT(tc::equal(vecn, vecnExpected));
+		}
+	}
+
+	// sorted and reverse sorted input, elements with non-trivial moves
+	auto vecstr = tc::make_vector(tc::transform(tc::iota(0, 5000), [](int const n) noexcept { return tc::make_str<char>(tc::as_dec(10000 - n)); }));
+	tc::sort_inplace(par, vecstr);
+	_ASSERT(tc::is_strictly_sorted(vecstr));
+	tc::sort_inplace(tc::par.on(threadpool).min_chunk_size(100), vecstr);
+	_ASSERT(tc::is_strictly_sorted(vecstr));
+}
+
+UNITTESTDEF(parallel_stable_sort_inplace) {
+	tc::thread_pool threadpool(3);
+	auto const par = tc::par.on(threadpool).min_chunk_size(100);
+
+	for( std::size_t const nSize : {0, 1, 150, 1000, 12345} ) {
+		auto const vecn = random_ints(nSize, 20);
+		auto vecpairn = tc::make_vector(tc::transform(tc::iota(0, tc::explicit_cast<int>(nSize)), [&](int const n) noexcept { return std::make_pair(vecn[n], n); }));
+		auto const LessFirst = [](auto const& lhs, auto const& rhs) noexcept { return lhs.first < rhs.first; };
+		tc::stable_sort_inplace(par, vecpairn, LessFirst);
+		_ASSERT(tc::is_strictly_sorted(vecpairn)); // stable: equal keys keep the order of their indices
+		_ASSERTEQUAL(tc::size(vecpairn), nSize);
+	}
+}
+
+UNITTESTDEF(parallel_sort_index) {
+	tc::thread_pool threadpool(3);
+	auto const par = tc::par.on(threadpool).min_chunk_size(100);
+
+	auto const vecn = random_ints(5000, 100);
+	_ASSERT(tc::equal(tc::sort(par, vecn), tc::sort(vecn)));
+	_ASSERT(tc::equal(
+		tc::transform(tc::stable_sort(par, vecn), [](int const& n) noexcept { return &n; }),
+		tc::transform(tc::stable_sort(vecn), [](int const& n) noexcept { return &n; })
+	));
+}
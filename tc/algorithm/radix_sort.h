@@ -0,0 +1,148 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/casts.h"
+#include "../base/modified.h"
+#include "../base/noncopyable.h"
+#include "../base/trivial_functors.h"
+
+#include "algorithm.h"
+#include "compare.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace tc {
+	namespace no_adl {
+		// Memory kept between radix sorts, so that repeated sorts do not allocate.
+		struct radix_scratch final : tc::noncopyable {
+			template<typename T>
+			[[nodiscard]] T* get(std::size_t const n) & noexcept {
+				static_assert( alignof(T) <= alignof(std::max_align_t) );
+				auto const nBlocks = (n * sizeof(T) + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+				if( m_nBlocks < nBlocks ) {
+					m_pblock.reset(); // free before allocating
+					m_pblock.reset(NOBADALLOC(new std::max_align_t[nBlocks]));
+					m_nBlocks = nBlocks;
+				}
+				return reinterpret_cast<T*>(m_pblock.get());
+			}
+
+		private:
+			std::unique_ptr<std::max_align_t[]> m_pblock;
+			std::size_t m_nBlocks = 0;
+		};
+
+		// Policy of radix sorts, e.g., tc::sort_inplace(tc::radix, rng, keyfn).
+		struct radix_t final {
+			radix_scratch* m_pscratch = nullptr; // nullptr: allocate for every sort
+
+			[[nodiscard]] constexpr radix_t scratch(radix_scratch& scratch) const& noexcept {
+				return tc_modified(*this, _.m_pscratch = std::addressof(scratch));
+			}
+		};
+	}
+	using no_adl::radix_scratch;
+	using no_adl::radix_t;
+	inline constexpr tc::radix_t radix{};
+
+	// Keys by which tc::sort_inplace(tc::radix, ...) sorts.
+	template<typename Key>
+	concept radix_key = std::is_integral<Key>::value || tc::enum_type<Key>;
+
+	namespace radix_sort_detail {
+		// Unsigned integer with the same order as key.
+		template<tc::radix_key Key>
+		[[nodiscard]] constexpr auto unsigned_key(Key const key) noexcept {
+			if constexpr( tc::enum_type<Key> || std::is_same<Key, bool>::value ) {
+				return unsigned_key(tc::to_underlying(key));
+			} else {
+				using unsigned_t = std::make_unsigned_t<Key>;
+				if constexpr( std::is_signed<Key>::value ) {
+					return static_cast<unsigned_t>(static_cast<unsigned_t>(key) ^ (unsigned_t(1) << (std::numeric_limits<unsigned_t>::digits - 1)));
+				} else {
+					return static_cast<unsigned_t>(key);
+				}
+			}
+		}
+
+		// Below this size, the histograms cost more than comparing.
+		inline constexpr std::size_t c_nMinRadixSort = 256;
+
+		// LSD radix sort with one pass per digit of the key, moving the elements between pt and ptBuffer. Wide keys use 11 bit
+		// digits, whose histograms still fit into the L2 cache. All histograms are counted in a single pass up front. Passes
+		// in which all elements have the same digit are skipped, so keys which only use their low bits are cheap.
+		template<typename T, typename KeyFn>
+		void lsd_radix_sort(T* const pt, std::size_t const n, T* const ptBuffer, KeyFn const& keyfn) noexcept {
+			using key_t = decltype(unsigned_key(tc::invoke(keyfn, *pt)));
+			static constexpr int c_nBits = std::numeric_limits<key_t>::digits;
+			static constexpr int c_nDigitBits = 16 < c_nBits ? 11 : 8;
+			static constexpr int c_nDigits = (c_nBits + c_nDigitBits - 1) / c_nDigitBits;
+			static constexpr key_t c_nDigitMask = (key_t(1) << c_nDigitBits) - 1;
+			auto const Digit = [&](T const& t, int const nDigit) noexcept {
+				return static_cast<std::size_t>((unsigned_key(tc::invoke(keyfn, t)) >> (nDigit * c_nDigitBits)) & c_nDigitMask);
+			};
+
+			auto const pannCount = std::make_unique<std::array<std::array<std::size_t, std::size_t(1) << c_nDigitBits>, c_nDigits>>();
+			auto& aanCount = *pannCount;
+			for( auto p = pt; p != pt + n; ++p ) {
+				auto const key = unsigned_key(tc::invoke(keyfn, *p));
+				for( int nDigit = 0; nDigit < c_nDigits; ++nDigit ) {
+					++aanCount[nDigit][static_cast<std::size_t>((key >> (nDigit * c_nDigitBits)) & c_nDigitMask)];
+				}
+			}
+
+			T* pSource = pt;
+			T* pTarget = ptBuffer;
+			for( int nDigit = 0; nDigit < c_nDigits; ++nDigit ) {
+				auto& anOffset = aanCount[nDigit];
+				if( n == anOffset[Digit(*pSource, nDigit)] ) continue;
+				std::size_t nOffset = 0;
+				for( auto& nCount : anOffset ) {
+					nOffset += std::exchange(nCount, nOffset);
+				}
+				for( auto p = pSource; p != pSource + n; ++p ) {
+					std::memcpy(pTarget + anOffset[Digit(*p, nDigit)]++, p, sizeof(T));
+				}
+				std::swap(pSource, pTarget);
+			}
+			if( pSource != pt ) {
+				std::memcpy(pt, pSource, n * sizeof(T));
+			}
+		}
+	}
+
+	// Stable sort by the integral or enum key keyfn(element), e.g., a member of the elements. Contiguous ranges of trivially
+	// copyable elements are radix sorted using a buffer as large as the range, which is taken from the scratch memory of the
+	// policy if it has one. Other ranges are sorted by std::stable_sort.
+	template<typename Rng, typename KeyFn = tc::identity>
+	void sort_inplace(tc::radix_t const radix, Rng&& rng, KeyFn&& keyfn = KeyFn()) noexcept {
+		using value_type = tc::range_value_t<Rng>;
+		static_assert( tc::radix_key<std::remove_cvref_t<decltype(tc::invoke(keyfn, std::declval<value_type const&>()))>>, "radix sort needs integral or enum keys" );
+		if constexpr( tc::contiguous_range<Rng> && std::is_trivially_copyable<value_type>::value ) {
+			auto const n = tc::explicit_cast<std::size_t>(tc::size(rng));
+			if( radix_sort_detail::c_nMinRadixSort <= n ) {
+				tc::radix_scratch scratchLocal;
+				auto& scratch = radix.m_pscratch ? *radix.m_pscratch : scratchLocal;
+				radix_sort_detail::lsd_radix_sort(tc::ptr_begin(rng), n, scratch.template get<value_type>(n), keyfn);
+				return;
+			}
+		}
+		tc::stable_sort_inplace(std::forward<Rng>(rng), tc::projected(tc::fn_less(), keyfn));
+	}
+
+	template<typename Cont, typename KeyFn = tc::identity>
+	void sort_unique_inplace(tc::radix_t const radix, Cont& cont, KeyFn&& keyfn = KeyFn()) noexcept {
+		tc::sort_inplace(radix, cont, keyfn);
+		tc::ordered_unique_inplace(cont, tc::projected(tc::fn_less(), keyfn));
+	}
+}
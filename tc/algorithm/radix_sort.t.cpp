@@ -0,0 +1,93 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/transform.h"
+#include "equal.h"
+#include "radix_sort.h"
+
+namespace {
+	template<typename T>
+	tc::vector<T> random_values(std::size_t const nSize) noexcept {
+		std::uint64_t nState = 4711;
+		tc::vector<T> vect;
+		for( std::size_t n = 0; n < nSize; ++n ) {
+			nState = nState * 6364136223846793005ull + 1442695040888963407ull;
+			tc::cont_emplace_back(vect, static_cast<T>(nState >> 17));
+		}
+		return vect;
+	}
+
+	template<typename T>
+	void check_radix_sort(std::size_t const nSize) noexcept {
+		auto vect = random_values<T>(nSize);
+		auto vectExpected = vect;
+		tc::sort_inplace(vectExpected);
+		tc::sort_inplace(tc::radix, vect);
+		_ASSERT(tc::equal(vect, vectExpected));
+	}
+
+	TC_DEFINE_ENUM(EColor, ecolor, (RED)(GREEN)(BLUE))
+
+	struct SItem final {
+		std::uint64_t m_nId;
+		EColor m_ecolor;
+		int m_nIndex;
+	};
+}
+
+UNITTESTDEF(radix_sort) {
+	for( std::size_t const nSize : {0, 1, 255, 256, 5000} ) {
+		check_radix_sort<std::uint64_t>(nSize);
+		check_radix_sort<std::int64_t>(nSize);
+		check_radix_sort<int>(nSize);
+		check_radix_sort<short>(nSize);
+		check_radix_sort<unsigned char>(nSize);
+		check_radix_sort<signed char>(nSize);
+		check_radix_sort<char16_t>(nSize);
+	}
+
+	// keys which differ only in the low byte skip the other passes
+	tc::vector<std::int64_t> vecn{-1, 1, -2, 2, 0, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+	for( int n = 0; n < 300; ++n ) tc::cont_emplace_back(vecn, n % 7);
+	auto vecnExpected = vecn;
+	tc::sort_inplace(vecnExpected);
+	tc::radix_scratch scratch;
+	tc::sort_inplace(tc::radix.scratch(scratch), vecn);
+	_ASSERT(tc::equal(vecn, vecnExpected));
+
+	tc::sort_unique_inplace(tc::radix.scratch(scratch), vecn);
+	_ASSERT(tc::equal(vecn, tc::vector<std::int64_t>{std::numeric_limits<std::int64_t>::min(), -2, -1, 0, 1, 2, 3, 4, 5, 6, std::numeric_limits<std::int64_t>::max()}));
+}
+
+UNITTESTDEF(radix_sort_projected) {
+	auto const vecnId = random_values<std::uint64_t>(3000);
+	tc::vector<SItem> vecitem;
+	for( int n = 0; n < 3000; ++n ) {
+		tc::cont_emplace_back(vecitem, SItem{vecnId[n] % 100, static_cast<EColor>(n % 3), n});
+	}
+
+	// stable by enum key
+	auto vecitemByColor = vecitem;
+	tc::sort_inplace(tc::radix, vecitemByColor, tc_member(.m_ecolor));
+	_ASSERT(tc::is_sorted(vecitemByColor, [](SItem const& lhs, SItem const& rhs) noexcept {
+		return lhs.m_ecolor < rhs.m_ecolor || (lhs.m_ecolor == rhs.m_ecolor && lhs.m_nIndex < rhs.m_nIndex);
+	}));
+
+	// stable by integral key, same result as the comparison sort
+	auto vecitemById = vecitem;
+	tc::sort_inplace(tc::radix, vecitemById, tc_member(.m_nId));
+	auto vecitemExpected = vecitem;
+	tc::stable_sort_inplace(vecitemExpected, tc::projected(tc::fn_less(), tc_member(.m_nId)));
+	_ASSERT(tc::equal(tc::transform(vecitemById, tc_member(.m_nIndex)), tc::transform(vecitemExpected, tc_member(.m_nIndex))));
+
+	// non-trivially copyable elements are sorted by comparison
+	tc::vector<tc::string<char>> vecstr{"ccc", "a", "bb", "", "dd"};
+	tc::sort_inplace(tc::radix, vecstr, [](tc::string<char> const& str) noexcept { return str.size(); });
+	_ASSERT(tc::equal(vecstr, tc::vector<tc::string<char>>{"", "a", "bb", "dd", "ccc"}));
+}
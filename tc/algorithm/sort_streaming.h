@@ -78,4 +78,35 @@ namespace tc {
 			return tc::constant<tc::continue_>();
 		});
 	}
+
+	template<typename Rng, typename Less = tc::fn_less>
+	auto sort_streaming_top_k(Rng&& rng, std::size_t const nTop, Less&& less = Less()) noexcept {
+		// Notes:
+		//  * generates the nTop smallest elements of rng in sorted order
+		//  * not a stable sort algorithm
+		//  * stores at most nTop elements, so rng may be a generator range of any size
+		return tc::generator_range_output<tc::range_value_t<Rng const&>&>([
+			rng = tc::make_reference_or_value(std::forward<Rng>(rng)),
+			nTop,
+			less = tc::decay_copy(std::forward<Less>(less))
+		](auto&& sink) MAYTHROW -> tc::common_type_t<decltype(tc::continue_if_not_break(sink, std::declval<tc::range_value_t<Rng const&>&>())), tc::constant<tc::continue_>> {
+			tc::vector<tc::range_value_t<Rng const&>> vec;
+			if( 0 < nTop ) {
+				// max-heap of the nTop smallest elements seen so far
+				tc::for_each(*rng, [&](auto&& t) MAYTHROW {
+					if( tc::size_raw(vec) < nTop ) {
+						tc::cont_emplace_back(vec, tc_move_if_owned(t)); // MAYTHROW
+						boost::range::push_heap(vec, less);
+					} else if( less(t, tc::front(vec)) ) {
+						tc::replace_heap(vec, tc::range_value_t<Rng const&>(tc_move_if_owned(t)), less);
+					}
+				});
+				boost::range::sort_heap(vec, less);
+			}
+			for( auto& t : vec ) {
+				tc_yield(sink, t); // MAYTHROW
+			}
+			return tc::constant<tc::continue_>();
+		});
+	}
 }
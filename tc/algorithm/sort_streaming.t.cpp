@@ -22,3 +22,15 @@ UNITTESTDEF( sort_streaming ) {
 		"9876543221100"
 	);
 }
+
+UNITTESTDEF( sort_streaming_top_k ) {
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("5714926380", 3)), "012" );
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("5714926380", 4, tc::fn_greater())), "9876" );
+	_ASSERTEQUAL( tc::make_str(tc::sort_streaming_top_k("5714926380", 20)), "0123456789" );
+	_ASSERT( tc::empty(tc::sort_streaming_top_k("5714926380", 0)) );
+
+	// generator ranges are consumed without being materialized
+	auto const rngn = tc::make_generator_range(tc::transform(tc::iota(0, 100000), [](int const n) noexcept { return n * 7919 % 100000; }));
+	_ASSERT( tc::equal(tc::sort_streaming_top_k(rngn, 5), tc::iota(0, 5)) );
+	_ASSERT( tc::equal(tc::sort_streaming_top_k(rngn, 3, tc::fn_greater()), tc::make_array(tc::aggregate_tag, 99999, 99998, 99997)) );
+}
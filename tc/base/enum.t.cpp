@@ -9,6 +9,7 @@
 #include "assert_defs.h"
 #include "enum.h"
 #include "../enumset.h"
+#include "../interval.h"
 #include "../unittest.h"
 
 #define TEST_ENUM(offset, constants, underlying) \
@@ -67,6 +68,58 @@ UNITTESTDEF(enumset_index_inc_dec) {
 }
 
 }
+
+TC_DEFINE_ENUM(EWide, ewide, CONSTANTS192)
+DEFINE_SUB_ENUM(EWide, EWideSub, ewidesub, (a0332)(a0333)(a1000)(a1001))
+
+namespace {
+UNITTESTDEF(enumset_word_array) {
+	STATICASSERTEQUAL( sizeof(tc::enumset<EWide>), 3 * sizeof(std::uint64_t) );
+
+	tc::enumset<EWide> setewide;
+	_ASSERT(!setewide);
+	setewide |= ewidea0001;
+	setewide |= ewidea1000;
+	setewide |= ewidea2333;
+	_ASSERTEQUAL(setewide.size(), 3);
+	_ASSERT(!setewide.is_singleton());
+
+	auto itewide = tc::begin(setewide);
+	_ASSERTEQUAL(*itewide++, ewidea0001);
+	_ASSERTEQUAL(*itewide++, ewidea1000); // skips the rest of the first word
+	_ASSERTEQUAL(*itewide++, ewidea2333); // skips the empty parts of the second and third words
+	_ASSERTEQUAL(itewide, tc::end(setewide));
+	_ASSERTEQUAL(*--itewide, ewidea2333);
+	_ASSERTEQUAL(*--itewide, ewidea1000);
+	_ASSERTEQUAL(*--itewide, ewidea0001);
+	_ASSERTEQUAL(itewide, tc::begin(setewide));
+
+	tc::vector<EWide> vecewide;
+	tc::for_each(setewide, [&](EWide const ewide) noexcept { tc::cont_emplace_back(vecewide, ewide); });
+	_ASSERT(tc::equal(vecewide, tc::vector<EWide>{ewidea0001, ewidea1000, ewidea2333}));
+	_ASSERTEQUAL(tc::find_first_if<tc::return_value_or_none>(setewide, [](EWide const ewide) noexcept { return ewidea0001 != ewide; }), ewidea1000);
+
+	auto const seteAll = tc::enumset<EWide>(tc::all_values<EWide>());
+	_ASSERTEQUAL(seteAll.size(), 192);
+	_ASSERTEQUAL((~setewide).size(), 189);
+	_ASSERT(tc::is_subset(setewide, seteAll));
+	_ASSERT(!tc::is_subset(seteAll, setewide));
+	_ASSERTEQUAL(seteAll - ~setewide, setewide);
+	_ASSERTEQUAL(setewide & tc::enumset<EWide>(ewidea1000), ewidea1000);
+	_ASSERT((setewide & tc::enumset<EWide>(ewidea1000)).is_singleton());
+	_ASSERTEQUAL(setewide ^ setewide, tc::enumset<EWide>());
+
+	auto const seteInterval = tc::enumset<EWide>(tc::make_interval(ewidea0330, ewidea1002));
+	_ASSERTEQUAL(seteInterval.size(), 6);
+	_ASSERTEQUAL(*tc::begin(seteInterval), ewidea0330);
+	_ASSERTEQUAL(*tc::begin(tc::reverse(seteInterval)), ewidea1001);
+
+	auto const setewidesub = tc::explicit_cast<tc::enumset<EWideSub>>(seteInterval & (ewidea0333 | ewidea1000));
+	_ASSERTEQUAL(setewidesub, ewidesuba0333 | ewidesuba1000);
+	_ASSERTEQUAL(tc::explicit_cast<tc::enumset<EWide>>(setewidesub), ewidea0333 | ewidea1000);
+}
+}
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
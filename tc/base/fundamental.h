@@ -43,8 +43,10 @@
 
 #ifdef _MSC_VER
 	#define TC_FORCEINLINE [[msvc::forceinline]]
-#else
+#elif defined(__clang__)
 	#define TC_FORCEINLINE [[gnu::always_inline, gnu::nodebug]]
+#else
+	#define TC_FORCEINLINE [[gnu::always_inline]] // GCC does not know nodebug
 #endif
 
 
@@ -67,6 +69,15 @@ namespace tc {
 	constexpr void discard(T&&) noexcept{}
 }
 
+// Lets the optimizer rely on a condition, which is not checked, even in debug builds.
+#ifdef _MSC_VER
+	#define TC_ASSUME(...) __assume(__VA_ARGS__)
+#elif defined(__clang__)
+	#define TC_ASSUME(...) __builtin_assume(__VA_ARGS__)
+#else
+	#define TC_ASSUME(...) (static_cast<bool>(__VA_ARGS__) ? static_cast<void>(0) : __builtin_unreachable())
+#endif
+
 #ifdef _MSC_VER
 	// MSVC generates null checks when upcasting this (https://godbolt.org/z/o6zhWaKGo).
 	#define MSVC_WORKAROUND_THIS (__assume(nullptr != this), this)
@@ -0,0 +1,199 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "assert_defs.h"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+// The instruction set is selected at compile time, e.g., by -mavx2 or /arch:AVX2. There is no runtime dispatch.
+#if defined(__AVX2__)
+	#define TC_SIMD_AVX2
+	#define TC_SIMD_SSE2
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+	#define TC_SIMD_SSE2
+	#include <emmintrin.h>
+	#if defined(__SSE4_1__)
+		#include <smmintrin.h>
+	#endif
+#endif
+
+namespace tc {
+	namespace simd {
+		// Types which compare equal if and only if their object representations are equal.
+		template<typename T>
+		concept bitwise_comparable =
+			(std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value) &&
+			std::has_unique_object_representations<T>::value &&
+			(1 == sizeof(T) || 2 == sizeof(T) || 4 == sizeof(T) || 8 == sizeof(T));
+
+		namespace no_adl {
+			template<std::size_t nSize> struct uint_of_size;
+			template<> struct uint_of_size<1> final { using type = std::uint8_t; };
+			template<> struct uint_of_size<2> final { using type = std::uint16_t; };
+			template<> struct uint_of_size<4> final { using type = std::uint32_t; };
+			template<> struct uint_of_size<8> final { using type = std::uint64_t; };
+		}
+		template<typename T>
+		using uint_of_size_t = typename no_adl::uint_of_size<sizeof(T)>::type;
+
+		template<bitwise_comparable T>
+		[[nodiscard]] inline uint_of_size_t<T> to_uint(T const t) noexcept {
+			return std::bit_cast<uint_of_size_t<T>>(t);
+		}
+
+#ifdef TC_SIMD_SSE2
+	#ifdef TC_SIMD_AVX2
+		using block = __m256i;
+		[[nodiscard]] inline block load(void const* pv) noexcept { return _mm256_loadu_si256(static_cast<block const*>(pv)); }
+		inline void store(void* pv, block const blk) noexcept { _mm256_storeu_si256(static_cast<block*>(pv), blk); }
+		// One bit per byte, set if the most significant bit of the byte is set.
+		[[nodiscard]] inline std::uint32_t byte_mask(block const blk) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_epi8(blk)); }
+		[[nodiscard]] inline block bit_and(block const lhs, block const rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+		[[nodiscard]] inline block bit_or(block const lhs, block const rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+
+		template<typename T>
+		[[nodiscard]] inline block broadcast(T const t) noexcept {
+			if constexpr( 1 == sizeof(T) ) return _mm256_set1_epi8(static_cast<char>(to_uint(t)));
+			else if constexpr( 2 == sizeof(T) ) return _mm256_set1_epi16(static_cast<short>(to_uint(t)));
+			else if constexpr( 4 == sizeof(T) ) return _mm256_set1_epi32(static_cast<int>(to_uint(t)));
+			else return _mm256_set1_epi64x(static_cast<long long>(to_uint(t)));
+		}
+
+		// All bits of a lane are set if the lanes of lhs and rhs are equal.
+		template<std::size_t nLaneSize>
+		[[nodiscard]] inline block equal(block const lhs, block const rhs) noexcept {
+			if constexpr( 1 == nLaneSize ) return _mm256_cmpeq_epi8(lhs, rhs);
+			else if constexpr( 2 == nLaneSize ) return _mm256_cmpeq_epi16(lhs, rhs);
+			else if constexpr( 4 == nLaneSize ) return _mm256_cmpeq_epi32(lhs, rhs);
+			else return _mm256_cmpeq_epi64(lhs, rhs);
+		}
+
+		// All bits of a lane are set if the lane of lhs is greater than the lane of rhs, compared as signed integers.
+		template<std::size_t nLaneSize>
+		[[nodiscard]] inline block greater(block const lhs, block const rhs) noexcept {
+			if constexpr( 1 == nLaneSize ) return _mm256_cmpgt_epi8(lhs, rhs);
+			else if constexpr( 2 == nLaneSize ) return _mm256_cmpgt_epi16(lhs, rhs);
+			else if constexpr( 4 == nLaneSize ) return _mm256_cmpgt_epi32(lhs, rhs);
+			else return _mm256_cmpgt_epi64(lhs, rhs);
+		}
+	#else
+		using block = __m128i;
+		[[nodiscard]] inline block load(void const* pv) noexcept { return _mm_loadu_si128(static_cast<block const*>(pv)); }
+		inline void store(void* pv, block const blk) noexcept { _mm_storeu_si128(static_cast<block*>(pv), blk); }
+		[[nodiscard]] inline std::uint32_t byte_mask(block const blk) noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(blk)); }
+		[[nodiscard]] inline block bit_and(block const lhs, block const rhs) noexcept { return _mm_and_si128(lhs, rhs); }
+		[[nodiscard]] inline block bit_or(block const lhs, block const rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+
+		template<typename T>
+		[[nodiscard]] inline block broadcast(T const t) noexcept {
+			if constexpr( 1 == sizeof(T) ) return _mm_set1_epi8(static_cast<char>(to_uint(t)));
+			else if constexpr( 2 == sizeof(T) ) return _mm_set1_epi16(static_cast<short>(to_uint(t)));
+			else if constexpr( 4 == sizeof(T) ) return _mm_set1_epi32(static_cast<int>(to_uint(t)));
+			else return _mm_set1_epi64x(static_cast<long long>(to_uint(t)));
+		}
+
+		template<std::size_t nLaneSize>
+		[[nodiscard]] inline block equal(block const lhs, block const rhs) noexcept {
+			if constexpr( 1 == nLaneSize ) return _mm_cmpeq_epi8(lhs, rhs);
+			else if constexpr( 2 == nLaneSize ) return _mm_cmpeq_epi16(lhs, rhs);
+			else if constexpr( 4 == nLaneSize ) return _mm_cmpeq_epi32(lhs, rhs);
+			else {
+		#ifdef __SSE4_1__
+				return _mm_cmpeq_epi64(lhs, rhs);
+		#else
+				// 64 bit lanes are equal if both 32 bit halves are equal.
+				auto const blk = _mm_cmpeq_epi32(lhs, rhs);
+				return _mm_and_si128(blk, _mm_shuffle_epi32(blk, _MM_SHUFFLE(2, 3, 0, 1)));
+		#endif
+			}
+		}
+
+		template<std::size_t nLaneSize>
+		[[nodiscard]] inline block greater(block const lhs, block const rhs) noexcept {
+			static_assert( nLaneSize <= 4, "64 bit comparison requires SSE4.2" );
+			if constexpr( 1 == nLaneSize ) return _mm_cmpgt_epi8(lhs, rhs);
+			else if constexpr( 2 == nLaneSize ) return _mm_cmpgt_epi16(lhs, rhs);
+			else return _mm_cmpgt_epi32(lhs, rhs);
+		}
+	#endif
+		inline constexpr std::size_t c_nBlockSize = sizeof(block);
+
+		// Zero-extends the bytes of the block at pSrc to 16 bit and stores them at pDst.
+		inline void store_widened(std::uint16_t* const pDst, std::uint8_t const* const pSrc) noexcept {
+	#ifdef TC_SIMD_AVX2
+			store(pDst, _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrc))));
+			store(pDst + 16, _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(pSrc + 16))));
+	#else
+			auto const blk = load(pSrc);
+			store(pDst, _mm_unpacklo_epi8(blk, _mm_setzero_si128()));
+			store(pDst + 8, _mm_unpackhi_epi8(blk, _mm_setzero_si128()));
+	#endif
+		}
+
+		// Stores the 16 bit lanes of blkLow and blkHigh, which must all be smaller than 0x100, as bytes at pDst.
+		inline void store_narrowed(std::uint8_t* const pDst, block const blkLow, block const blkHigh) noexcept {
+	#ifdef TC_SIMD_AVX2
+			// _mm256_packus_epi16 interleaves the 128 bit lanes of its arguments.
+			store(pDst, _mm256_permute4x64_epi64(_mm256_packus_epi16(blkLow, blkHigh), 0xd8));
+	#else
+			store(pDst, _mm_packus_epi16(blkLow, blkHigh));
+	#endif
+		}
+#endif
+
+		// Copies the longest prefix of [pBegin, pEnd) that consists of whole blocks of ASCII code units to pDst, converting between
+		// 8 and 16 bit code units. Returns the end of the copied prefix; the caller handles the remaining code units.
+		template<typename Dst, typename Src>
+		[[nodiscard]] Src const* convert_ascii_prefix(Src const* pBegin, Src const* const pEnd, [[maybe_unused]] Dst* pDst) noexcept {
+			static_assert( (1 == sizeof(Src) && 2 == sizeof(Dst)) || (2 == sizeof(Src) && 1 == sizeof(Dst)) );
+#ifdef TC_SIMD_SSE2
+			if constexpr( 1 == sizeof(Src) ) {
+				for( ; static_cast<std::ptrdiff_t>(c_nBlockSize) <= pEnd - pBegin; pBegin += c_nBlockSize, pDst += c_nBlockSize ) {
+					if( 0 != tc::simd::byte_mask(tc::simd::load(pBegin)) ) break;
+					tc::simd::store_widened(reinterpret_cast<std::uint16_t*>(pDst), reinterpret_cast<std::uint8_t const*>(pBegin));
+				}
+			} else {
+				static constexpr std::ptrdiff_t c_nPerBlock = c_nBlockSize / 2;
+				static constexpr std::uint32_t c_nAllBytes = static_cast<std::uint32_t>((std::uint64_t(1) << c_nBlockSize) - 1);
+				auto const blkNonAscii = tc::simd::broadcast(std::uint16_t(0xff80));
+				auto const blkZero = tc::simd::broadcast(std::uint16_t(0));
+				for( ; 2 * c_nPerBlock <= pEnd - pBegin; pBegin += 2 * c_nPerBlock, pDst += 2 * c_nPerBlock ) {
+					auto const blkLow = tc::simd::load(pBegin);
+					auto const blkHigh = tc::simd::load(pBegin + c_nPerBlock);
+					if( c_nAllBytes != tc::simd::byte_mask(tc::simd::equal<2>(tc::simd::bit_and(tc::simd::bit_or(blkLow, blkHigh), blkNonAscii), blkZero)) ) break;
+					tc::simd::store_narrowed(reinterpret_cast<std::uint8_t*>(pDst), blkLow, blkHigh);
+				}
+			}
+#endif
+			return pBegin;
+		}
+
+		// Returns pointer to the first element equal to t in [pBegin, pEnd) or pEnd.
+		template<bitwise_comparable T>
+		[[nodiscard]] T const* find_first_equal(T const* pBegin, T const* const pEnd, T const t) noexcept {
+#ifdef TC_SIMD_SSE2
+			static constexpr std::ptrdiff_t c_nPerBlock = c_nBlockSize / sizeof(T);
+			auto const blkT = tc::simd::broadcast(t);
+			for( ; c_nPerBlock <= pEnd - pBegin; pBegin += c_nPerBlock ) {
+				if( auto const nMask = tc::simd::byte_mask(tc::simd::equal<sizeof(T)>(tc::simd::load(pBegin), blkT)) ) {
+					return pBegin + std::countr_zero(nMask) / sizeof(T);
+				}
+			}
+#endif
+			auto const nT = tc::simd::to_uint(t);
+			for( ; pBegin != pEnd; ++pBegin ) {
+				if( tc::simd::to_uint(*pBegin) == nT ) return pBegin;
+			}
+			return pEnd;
+		}
+	}
+}
@@ -452,7 +452,33 @@ namespace tc {
 			push_back_t<List, T>
 		>;
 
+		namespace no_adl {
+			template<typename... T>
+			struct unique_set final : tc::type::identity<T>... {
+				template<typename U>
+				friend auto operator+(unique_set, tc::type::identity<U>) noexcept -> std::conditional_t<
+					std::is_base_of<tc::type::identity<U>, unique_set>::value,
+					unique_set,
+					unique_set<T..., U>
+				>;
+
+				using list_type = list<T...>;
+			};
+
+			template<typename List>
+			struct unique;
+
+			// Removes duplicates, keeping first occurrences. Folding over the elements instead of recursing does not run into
+			// the template instantiation depth limit for long lists, e.g., the results of all combinations of alternatives of
+			// several variants.
+			template<typename... T>
+			struct unique<list<T...>> final {
+				using type = typename std::remove_reference_t<decltype((std::declval<unique_set<>>() + ... + std::declval<tc::type::identity<T>>()))>::list_type;
+			};
+		}
+		using no_adl::unique;
+
 		template<typename List>
-		using unique_t = accumulate_t<list<>, List, push_back_if_missing_t>;
+		using unique_t = typename unique<List>::type;
 	}
 }
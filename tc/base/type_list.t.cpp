@@ -22,6 +22,9 @@ STATICASSERTSAME(tc::type::list<>, (tc::type::filter_t<tc::type::list<char, int,
 STATICASSERTSAME((tc::type::list<char const*, tc::string<char>>), (tc::type::filter_t<tc::type::list<char, char const*, int, double, std::vector<int>, tc::string<char>, void>, tc::is_char_range>));
 STATICASSERTSAME((tc::type::list<char const*, tc::char16 const*>), (tc::type::filter_t<tc::type::list<char const*, tc::char16 const*>, tc::is_char_range>));
 
+STATICASSERTSAME(tc::type::list<>, tc::type::unique_t<tc::type::list<>>);
+STATICASSERTSAME((tc::type::list<int, char, int const&>), (tc::type::unique_t<tc::type::list<int, char, int, int const&, char, int const&>>));
+
 STATICASSERTSAME(char const*, (tc::type::find_unique_if_t<tc::type::list<char, char const*, int, double, std::vector<int>, void>, tc::is_char_range>));
 STATICASSERTEQUAL(0, (tc::type::find_unique_if<tc::type::list<char const*, char, int, double, std::vector<int>, void>, tc::is_char_range>::index));
 static_assert(tc::type::find_unique_if<tc::type::list<char, char const*, int, double, std::vector<int>, void>, tc::is_char_range>::found);
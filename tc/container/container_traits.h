@@ -25,6 +25,12 @@ namespace tc {
 	template<typename Cont, typename... T>
 	using has_emplace_back = no_adl::has_emplace_back<void, Cont, T...>;
 
+	template<typename Alloc>
+	concept allocator = requires(Alloc& alloc, typename Alloc::value_type* p) {
+		{ alloc.allocate(std::size_t(1)) } -> std::same_as<typename Alloc::value_type*>;
+		alloc.deallocate(p, std::size_t(1));
+	};
+
 	// Todo: move those below into namespace
 }
 
@@ -0,0 +1,684 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/type_traits.h"
+#include "../base/tc_move.h"
+#include "../base/casts.h"
+#include "../base/explicit_cast.h"
+#include "../base/modified.h"
+#include "../base/simd.h"
+#include "container.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace tc {
+	namespace flat_hash_detail {
+		// Control bytes: every slot has one control byte, which is either one of the special values below or, for full slots,
+		// the 7 lowest bits of the hash of the element. The groups of control bytes are scanned in parallel.
+		using ctrl_t = std::int8_t;
+		inline constexpr ctrl_t c_ctrlEmpty = -128;
+		inline constexpr ctrl_t c_ctrlDeleted = -2;
+		inline constexpr ctrl_t c_ctrlSentinel = -1; // marks the end of the slots for iteration
+
+		[[nodiscard]] constexpr bool is_full(ctrl_t const ctrl) noexcept { return 0 <= ctrl; }
+
+#ifdef TC_SIMD_SSE2
+		inline constexpr std::size_t c_nGroupWidth = tc::simd::c_nBlockSize;
+
+		struct group final {
+			explicit group(ctrl_t const* const pctrl) noexcept : m_blk(tc::simd::load(pctrl)) {}
+
+			// One bit per control byte equal to ctrl.
+			[[nodiscard]] std::uint32_t match(ctrl_t const ctrl) const& noexcept {
+				return tc::simd::byte_mask(tc::simd::equal<1>(m_blk, tc::simd::broadcast(ctrl)));
+			}
+			[[nodiscard]] std::uint32_t match_empty_or_deleted() const& noexcept {
+				return tc::simd::byte_mask(tc::simd::greater<1>(tc::simd::broadcast(c_ctrlSentinel), m_blk));
+			}
+
+		private:
+			tc::simd::block m_blk;
+		};
+#else
+		inline constexpr std::size_t c_nGroupWidth = 8;
+
+		struct group final {
+			explicit group(ctrl_t const* const pctrl) noexcept : m_pctrl(pctrl) {}
+
+			[[nodiscard]] std::uint32_t match(ctrl_t const ctrl) const& noexcept {
+				std::uint32_t nMask = 0;
+				for( std::size_t n = 0; n < c_nGroupWidth; ++n ) {
+					if( ctrl == m_pctrl[n] ) nMask |= std::uint32_t(1) << n;
+				}
+				return nMask;
+			}
+			[[nodiscard]] std::uint32_t match_empty_or_deleted() const& noexcept {
+				std::uint32_t nMask = 0;
+				for( std::size_t n = 0; n < c_nGroupWidth; ++n ) {
+					if( m_pctrl[n] < c_ctrlSentinel ) nMask |= std::uint32_t(1) << n;
+				}
+				return nMask;
+			}
+
+		private:
+			ctrl_t const* m_pctrl;
+		};
+#endif
+
+		// Control bytes of tables without slots: lookups find an empty slot, iteration stops at the sentinel.
+		alignas(c_nGroupWidth) inline constexpr std::array<ctrl_t, c_nGroupWidth> c_actrlEmptyTable = []() noexcept {
+			std::array<ctrl_t, c_nGroupWidth> actrl;
+			actrl.fill(c_ctrlEmpty);
+			actrl[0] = c_ctrlSentinel;
+			return actrl;
+		}();
+
+		// Never written to: tables without slots have no slots to insert into.
+		[[nodiscard]] inline ctrl_t* empty_table_ctrl() noexcept { return const_cast<ctrl_t*>(c_actrlEmptyTable.data()); }
+
+		// Triangular probing over groups, which visits every group once if the number of slots is a power of 2.
+		struct probe_seq final {
+			probe_seq(std::size_t const nHash, std::size_t const nMask) noexcept
+				: m_nMask(nMask)
+				, m_nOffset(nHash & nMask)
+			{}
+
+			[[nodiscard]] std::size_t offset(std::size_t const n) const& noexcept { return (m_nOffset + n) & m_nMask; }
+			[[nodiscard]] std::size_t offset() const& noexcept { return m_nOffset; }
+
+			void next() & noexcept {
+				m_nIndex += c_nGroupWidth;
+				m_nOffset = (m_nOffset + m_nIndex) & m_nMask;
+				_ASSERTDEBUG(m_nIndex <= m_nMask + c_nGroupWidth); // table is full
+			}
+
+		private:
+			std::size_t m_nMask;
+			std::size_t m_nOffset;
+			std::size_t m_nIndex = 0;
+		};
+
+		// Hashes of std::hash are often the identity. Spread the entropy over all bits, because the lowest 7 bits are stored
+		// in the control bytes and the remaining bits select the group.
+		[[nodiscard]] constexpr std::size_t mix(std::size_t const nHash) noexcept {
+			auto const n = static_cast<std::uint64_t>(nHash) * 0x9e3779b97f4a7c15ull;
+			return static_cast<std::size_t>(n ^ (n >> 32));
+		}
+
+		[[nodiscard]] constexpr ctrl_t h2(std::size_t const nHash) noexcept { return static_cast<ctrl_t>(nHash & 0x7f); }
+		[[nodiscard]] constexpr std::size_t h1(std::size_t const nHash) noexcept { return nHash >> 7; }
+
+		// The number of elements that fit into nCapacity slots while keeping the load factor below 7/8.
+		// At least one slot stays empty, so that every probe sequence terminates.
+		[[nodiscard]] constexpr std::size_t capacity_to_growth(std::size_t const nCapacity) noexcept {
+			return nCapacity - (nCapacity + 1) / 8;
+		}
+
+		// The smallest valid capacity, i.e., 2^n-1 but at least c_nGroupWidth-1, that holds nSize elements.
+		[[nodiscard]] constexpr std::size_t growth_to_capacity(std::size_t const nSize) noexcept {
+			std::size_t nCapacity = c_nGroupWidth - 1;
+			while( capacity_to_growth(nCapacity) < nSize ) nCapacity = nCapacity * 2 + 1;
+			return nCapacity;
+		}
+
+		template<typename Key>
+		struct set_policy final {
+			using key_type = Key;
+			using value_type = Key;
+			using mutable_value_type = Key;
+
+			static constexpr bool c_bConstElements = true; // elements are keys
+
+			using slot_type = Key;
+
+			[[nodiscard]] static constexpr key_type const& key(value_type const& val) noexcept { return val; }
+			[[nodiscard]] static constexpr value_type& element(slot_type& slot) noexcept { return slot; }
+
+			// Moves the element of slotSrc into the uninitialized slotDst and destroys the source.
+			template<typename Alloc>
+			static void transfer(Alloc& alloc, slot_type* const pslotDst, slot_type* const pslotSrc) noexcept {
+				std::allocator_traits<Alloc>::construct(alloc, pslotDst, tc_move_always(*pslotSrc));
+				std::allocator_traits<Alloc>::destroy(alloc, pslotSrc);
+			}
+		};
+
+		template<typename Key, typename T>
+		struct map_policy final {
+			using key_type = Key;
+			using mapped_type = T;
+			using value_type = std::pair<Key const, T>;
+			using mutable_value_type = std::pair<Key, T>;
+
+			static constexpr bool c_bConstElements = false;
+
+			// As in Abseil, a slot holds the element as std::pair<Key const, T>, but keys are moved out through the layout-compatible
+			// std::pair<Key, T> when the table grows, instead of casting away the constness of an object declared const.
+			union slot_type {
+				value_type m_val;
+				mutable_value_type m_valMutable;
+
+				slot_type() noexcept {}
+				~slot_type() {}
+			};
+			static_assert( sizeof(value_type) == sizeof(mutable_value_type) && alignof(value_type) == alignof(mutable_value_type) );
+
+			[[nodiscard]] static constexpr key_type const& key(value_type const& val) noexcept { return val.first; }
+			[[nodiscard]] static constexpr key_type const& key(mutable_value_type const& val) noexcept { return val.first; }
+			[[nodiscard]] static constexpr value_type& element(slot_type& slot) noexcept { return slot.m_val; }
+
+			// Moves the element of slotSrc into the uninitialized slotDst and destroys the source.
+			template<typename Alloc>
+			static void transfer(Alloc& alloc, slot_type* const pslotDst, slot_type* const pslotSrc) noexcept {
+				std::allocator_traits<Alloc>::construct(alloc, std::addressof(pslotDst->m_valMutable), tc_move_always(pslotSrc->m_valMutable));
+				std::allocator_traits<Alloc>::destroy(alloc, std::addressof(pslotSrc->m_valMutable));
+			}
+		};
+
+		template<typename T>
+		concept transparent = requires { typename T::is_transparent; };
+
+		template<typename Key, typename... Args>
+		inline constexpr bool c_bKeyAndMapped = false;
+		template<typename Key, typename KeyArg, typename MappedArg>
+		inline constexpr bool c_bKeyAndMapped<Key, KeyArg, MappedArg> = std::is_same<std::remove_cvref_t<KeyArg>, Key>::value;
+
+#ifdef TC_PRIVATE
+		template<typename Key>
+		using default_hash = tc::fn_hash<std::size_t, Key>;
+		using default_key_equal = tc::fn_equal_to;
+#else
+		template<typename Key>
+		using default_hash = std::hash<Key>;
+		using default_key_equal = std::equal_to<>;
+#endif
+	}
+
+	namespace no_adl {
+		// Open-addressing hash table in the style of Swiss tables: elements are stored inline in a single array of slots,
+		// a parallel array of control bytes holds 7 bits of the hash of every element. Lookups load a group of control bytes
+		// at once and compare the keys of matching slots only, so a lookup usually costs one cache miss on the control bytes
+		// and one on the element.
+		// Unlike std::unordered_map, insertions invalidate all iterators and references, and elements must be nothrow movable.
+		template<typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+		struct flat_hash_table {
+			using key_type = typename Policy::key_type;
+			using value_type = typename Policy::value_type;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using hasher = Hash;
+			using key_equal = KeyEqual;
+			using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+			using reference = value_type&;
+			using const_reference = value_type const&;
+
+			// Elements are moved when the table grows, for maps including the mapped values.
+			static_assert( std::is_nothrow_move_constructible<typename Policy::mutable_value_type>::value );
+			static_assert( std::is_nothrow_destructible<value_type>::value );
+
+		private:
+			using ctrl_t = flat_hash_detail::ctrl_t;
+			using slot_type = typename Policy::slot_type;
+			using ctrl_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<ctrl_t>;
+			using slot_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>;
+			using slot_traits = std::allocator_traits<slot_allocator_type>;
+
+			template<bool bConst>
+			struct iterator_impl {
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = typename Policy::value_type;
+				using difference_type = std::ptrdiff_t;
+				using reference = std::conditional_t<bConst || Policy::c_bConstElements, value_type const&, value_type&>;
+				using pointer = std::conditional_t<bConst || Policy::c_bConstElements, value_type const*, value_type*>;
+
+				iterator_impl() noexcept = default;
+				template<bool bConstOther> requires bConst && (!bConstOther)
+				iterator_impl(iterator_impl<bConstOther> const& it) noexcept
+					: m_pctrl(it.m_pctrl)
+					, m_pslot(it.m_pslot)
+				{}
+
+				[[nodiscard]] reference operator*() const& noexcept { _ASSERTDEBUG(flat_hash_detail::is_full(*m_pctrl)); return Policy::element(*m_pslot); }
+				[[nodiscard]] pointer operator->() const& noexcept { return std::addressof(**this); }
+
+				iterator_impl& operator++() & noexcept {
+					_ASSERTDEBUG(flat_hash_detail::is_full(*m_pctrl));
+					++m_pctrl;
+					++m_pslot;
+					skip_empty_or_deleted();
+					return *this;
+				}
+				iterator_impl operator++(int) & noexcept {
+					auto it = *this;
+					++*this;
+					return it;
+				}
+
+				[[nodiscard]] friend bool operator==(iterator_impl const& lhs, iterator_impl const& rhs) noexcept {
+					return lhs.m_pctrl == rhs.m_pctrl;
+				}
+
+			private:
+				friend struct flat_hash_table;
+				template<bool> friend struct iterator_impl;
+
+				iterator_impl(ctrl_t const* const pctrl, slot_type* const pslot) noexcept
+					: m_pctrl(pctrl)
+					, m_pslot(pslot)
+				{}
+
+				void skip_empty_or_deleted() & noexcept {
+					while( *m_pctrl < flat_hash_detail::c_ctrlSentinel ) {
+						++m_pctrl;
+						++m_pslot;
+					}
+				}
+
+				ctrl_t const* m_pctrl = nullptr;
+				slot_type* m_pslot = nullptr;
+			};
+
+		public:
+			using iterator = iterator_impl<false>;
+			using const_iterator = iterator_impl<true>;
+
+			flat_hash_table() = default;
+
+			explicit flat_hash_table(size_type const nReserve, Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual(), Alloc const& alloc = Alloc()) MAYTHROW
+				: m_hash(hash)
+				, m_equal(equal)
+				, m_alloc(alloc)
+			{
+				reserve(nReserve); // MAYTHROW
+			}
+
+			explicit flat_hash_table(Alloc const& alloc) MAYTHROW
+				: m_alloc(alloc)
+			{}
+
+			flat_hash_table(std::initializer_list<value_type> ilval) MAYTHROW
+				: flat_hash_table(ilval.size())
+			{
+				for( auto const& val : ilval ) emplace(val); // MAYTHROW
+			}
+
+			flat_hash_table(flat_hash_table const& other) MAYTHROW
+				: flat_hash_table(other.size(), other.m_hash, other.m_equal, slot_traits::select_on_container_copy_construction(other.m_alloc))
+			{
+				// Elements are rehashed instead of copying slot by slot, which keeps probe sequences short and drops deleted slots.
+				for( auto const& val : other ) {
+					auto const nHash = hash_of(Policy::key(val)); // MAYTHROW
+					auto const n = prepare_insert(nHash);
+					slot_traits::construct(m_alloc, std::addressof(Policy::element(m_pslot[n])), val); // MAYTHROW
+					commit_insert(n, nHash);
+				}
+			}
+
+			flat_hash_table(flat_hash_table&& other) noexcept
+				: m_pctrl(std::exchange(other.m_pctrl, flat_hash_detail::empty_table_ctrl()))
+				, m_pslot(std::exchange(other.m_pslot, nullptr))
+				, m_nCapacity(std::exchange(other.m_nCapacity, 0))
+				, m_nSize(std::exchange(other.m_nSize, 0))
+				, m_nGrowthLeft(std::exchange(other.m_nGrowthLeft, 0))
+				, m_hash(other.m_hash)
+				, m_equal(other.m_equal)
+				, m_alloc(tc_move(other.m_alloc))
+			{}
+
+			flat_hash_table& operator=(flat_hash_table const& other) & MAYTHROW {
+				if( this != std::addressof(other) ) {
+					flat_hash_table(other).swap(*this); // MAYTHROW
+				}
+				return *this;
+			}
+
+			flat_hash_table& operator=(flat_hash_table&& other) & noexcept {
+				flat_hash_table(tc_move(other)).swap(*this);
+				return *this;
+			}
+
+			~flat_hash_table() {
+				destroy_and_deallocate();
+			}
+
+			void swap(flat_hash_table& other) & noexcept {
+				_ASSERT(slot_traits::propagate_on_container_swap::value || m_alloc == other.m_alloc);
+				using std::swap;
+				swap(m_pctrl, other.m_pctrl);
+				swap(m_pslot, other.m_pslot);
+				swap(m_nCapacity, other.m_nCapacity);
+				swap(m_nSize, other.m_nSize);
+				swap(m_nGrowthLeft, other.m_nGrowthLeft);
+				swap(m_hash, other.m_hash);
+				swap(m_equal, other.m_equal);
+				if constexpr( slot_traits::propagate_on_container_swap::value ) {
+					swap(m_alloc, other.m_alloc);
+				}
+			}
+			friend void swap(flat_hash_table& lhs, flat_hash_table& rhs) noexcept {
+				lhs.swap(rhs);
+			}
+
+			[[nodiscard]] iterator begin() & noexcept {
+				return tc_modified(iterator(m_pctrl, m_pslot), _.skip_empty_or_deleted());
+			}
+			[[nodiscard]] const_iterator begin() const& noexcept {
+				return tc::as_mutable(*this).begin();
+			}
+			[[nodiscard]] iterator end() & noexcept {
+				return iterator(m_pctrl + m_nCapacity, m_pslot + m_nCapacity);
+			}
+			[[nodiscard]] const_iterator end() const& noexcept {
+				return tc::as_mutable(*this).end();
+			}
+
+			[[nodiscard]] size_type size() const& noexcept { return m_nSize; }
+			[[nodiscard]] bool empty() const& noexcept { return 0 == m_nSize; }
+			[[nodiscard]] size_type capacity() const& noexcept { return m_nCapacity; }
+			[[nodiscard]] hasher hash_function() const& noexcept { return m_hash; }
+			[[nodiscard]] key_equal key_eq() const& noexcept { return m_equal; }
+			[[nodiscard]] allocator_type get_allocator() const& noexcept { return allocator_type(m_alloc); }
+
+			void clear() & noexcept {
+				destroy_and_deallocate();
+				m_pctrl = flat_hash_detail::empty_table_ctrl();
+				m_pslot = nullptr;
+				m_nCapacity = 0;
+				m_nSize = 0;
+				m_nGrowthLeft = 0;
+			}
+
+			// Makes room for nSize elements without further rehashing.
+			void reserve(size_type const nSize) & MAYTHROW {
+				if( flat_hash_detail::capacity_to_growth(m_nCapacity) < nSize ) {
+					resize(flat_hash_detail::growth_to_capacity(nSize)); // MAYTHROW
+				}
+			}
+
+			template<typename K = key_type> requires std::is_same<K, key_type>::value || (flat_hash_detail::transparent<Hash> && flat_hash_detail::transparent<KeyEqual>)
+			[[nodiscard]] iterator find(K const& key) & MAYTHROW {
+				auto const nHash = hash_of(key); // MAYTHROW
+				if( auto const on = find_index(key, nHash) ) { // MAYTHROW
+					return iterator(m_pctrl + *on, m_pslot + *on);
+				} else {
+					return end();
+				}
+			}
+			template<typename K = key_type> requires std::is_same<K, key_type>::value || (flat_hash_detail::transparent<Hash> && flat_hash_detail::transparent<KeyEqual>)
+			[[nodiscard]] const_iterator find(K const& key) const& MAYTHROW {
+				return tc::as_mutable(*this).find(key); // MAYTHROW
+			}
+
+			template<typename K = key_type> requires std::is_same<K, key_type>::value || (flat_hash_detail::transparent<Hash> && flat_hash_detail::transparent<KeyEqual>)
+			[[nodiscard]] bool contains(K const& key) const& MAYTHROW {
+				return end() != find(key); // MAYTHROW
+			}
+			template<typename K = key_type> requires std::is_same<K, key_type>::value || (flat_hash_detail::transparent<Hash> && flat_hash_detail::transparent<KeyEqual>)
+			[[nodiscard]] size_type count(K const& key) const& MAYTHROW {
+				return contains(key) ? 1 : 0; // MAYTHROW
+			}
+
+			// Like std::unordered_map::emplace. If the arguments are a key, or a key and the mapped value, the element is only
+			// constructed if the key is not present yet.
+			template<typename... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) & MAYTHROW {
+				if constexpr( Policy::c_bConstElements && 1 == sizeof...(Args) && (std::is_same<std::remove_cvref_t<Args>, key_type>::value && ...) ) {
+					return emplace_with_key(args..., std::forward<Args>(args)...); // MAYTHROW
+				} else if constexpr( !Policy::c_bConstElements && flat_hash_detail::c_bKeyAndMapped<key_type, Args...> ) {
+					return [&](auto&& key, auto&& mapped) MAYTHROW {
+						return emplace_with_key(key, std::piecewise_construct, std::forward_as_tuple(tc_move_if_owned(key)), std::forward_as_tuple(tc_move_if_owned(mapped))); // MAYTHROW
+					}(std::forward<Args>(args)...);
+				} else {
+					// Construct the element first to find its key. It is moved into its slot if the key is not present.
+					typename Policy::mutable_value_type val(std::forward<Args>(args)...); // MAYTHROW
+					auto const nHash = hash_of(Policy::key(val)); // MAYTHROW
+					if( auto const on = find_index(Policy::key(val), nHash) ) { // MAYTHROW
+						return std::make_pair(iterator(m_pctrl + *on, m_pslot + *on), false);
+					}
+					auto const n = prepare_insert(nHash); // MAYTHROW
+					slot_traits::construct(m_alloc, std::addressof(Policy::element(m_pslot[n])), tc_move(val));
+					commit_insert(n, nHash);
+					return std::make_pair(iterator(m_pctrl + n, m_pslot + n), true);
+				}
+			}
+
+			std::pair<iterator, bool> insert(value_type const& val) & MAYTHROW {
+				return emplace(val); // MAYTHROW
+			}
+			std::pair<iterator, bool> insert(value_type&& val) & MAYTHROW {
+				return emplace(tc_move(val)); // MAYTHROW
+			}
+
+			iterator erase(iterator const it) & noexcept {
+				return erase(const_iterator(it));
+			}
+
+			iterator erase(const_iterator const itc) & noexcept {
+				auto const n = tc::explicit_cast<size_type>(itc.m_pctrl - m_pctrl);
+				_ASSERTDEBUG(n < m_nCapacity && flat_hash_detail::is_full(m_pctrl[n]));
+				slot_traits::destroy(m_alloc, std::addressof(Policy::element(m_pslot[n])));
+				--m_nSize;
+				// If no probe sequence ever found the group around the slot full, it never continued beyond it.
+				// The slot can then become empty again instead of a tombstone.
+				auto const nMaskEmptyBefore = flat_hash_detail::group(m_pctrl + ((n - flat_hash_detail::c_nGroupWidth) & m_nCapacity)).match(flat_hash_detail::c_ctrlEmpty);
+				auto const nMaskEmptyAfter = flat_hash_detail::group(m_pctrl + n).match(flat_hash_detail::c_ctrlEmpty);
+				if( 0 != nMaskEmptyBefore && 0 != nMaskEmptyAfter &&
+					tc::explicit_cast<std::size_t>(std::countr_zero(nMaskEmptyAfter) + std::countl_zero(nMaskEmptyBefore << (32 - flat_hash_detail::c_nGroupWidth))) < flat_hash_detail::c_nGroupWidth
+				) {
+					set_ctrl(n, flat_hash_detail::c_ctrlEmpty);
+					++m_nGrowthLeft;
+				} else {
+					set_ctrl(n, flat_hash_detail::c_ctrlDeleted);
+				}
+				return tc_modified(iterator(m_pctrl + n, m_pslot + n), _.skip_empty_or_deleted());
+			}
+
+			iterator erase(const_iterator itcBegin, const_iterator const itcEnd) & noexcept {
+				while( itcBegin != itcEnd ) {
+					itcBegin = erase(itcBegin);
+				}
+				return iterator(itcEnd.m_pctrl, itcEnd.m_pslot);
+			}
+
+			template<typename K = key_type> requires std::is_same<K, key_type>::value || (flat_hash_detail::transparent<Hash> && flat_hash_detail::transparent<KeyEqual> && !std::is_convertible<K const&, const_iterator>::value)
+			size_type erase(K const& key) & MAYTHROW {
+				if( auto const it = find(key); end() != it ) { // MAYTHROW
+					erase(it);
+					return 1;
+				} else {
+					return 0;
+				}
+			}
+
+			[[nodiscard]] friend bool operator==(flat_hash_table const& lhs, flat_hash_table const& rhs) MAYTHROW {
+				if( lhs.size() != rhs.size() ) return false;
+				for( auto const& val : lhs ) {
+					auto const it = rhs.find(Policy::key(val)); // MAYTHROW
+					if( rhs.end() == it || !(val == *it) ) return false; // MAYTHROW
+				}
+				return true;
+			}
+
+		protected:
+			// Looks up key and constructs the element from args only if the key is not present.
+			template<typename K, typename... Args>
+			std::pair<iterator, bool> emplace_with_key(K const& key, Args&&... args) & MAYTHROW {
+				auto const nHash = hash_of(key); // MAYTHROW
+				if( auto const on = find_index(key, nHash) ) { // MAYTHROW
+					return std::make_pair(iterator(m_pctrl + *on, m_pslot + *on), false);
+				}
+				auto const n = prepare_insert(nHash); // MAYTHROW
+				slot_traits::construct(m_alloc, std::addressof(Policy::element(m_pslot[n])), std::forward<Args>(args)...); // MAYTHROW
+				commit_insert(n, nHash);
+				return std::make_pair(iterator(m_pctrl + n, m_pslot + n), true);
+			}
+
+		private:
+			template<typename K>
+			[[nodiscard]] std::size_t hash_of(K const& key) const& MAYTHROW {
+				return flat_hash_detail::mix(m_hash(key)); // MAYTHROW
+			}
+
+			template<typename K>
+			[[nodiscard]] std::optional<size_type> find_index(K const& key, std::size_t const nHash) const& MAYTHROW {
+				flat_hash_detail::probe_seq seq(flat_hash_detail::h1(nHash), m_nCapacity);
+				for(;;) {
+					flat_hash_detail::group const grp(m_pctrl + seq.offset());
+					for( auto nMask = grp.match(flat_hash_detail::h2(nHash)); 0 != nMask; nMask &= nMask - 1 ) {
+						auto const n = seq.offset(tc::explicit_cast<std::size_t>(std::countr_zero(nMask)));
+						if( m_equal(Policy::key(Policy::element(m_pslot[n])), key) ) return n; // MAYTHROW
+					}
+					if( 0 != grp.match(flat_hash_detail::c_ctrlEmpty) ) return std::nullopt;
+					seq.next();
+				}
+			}
+
+			// Returns the first empty or deleted slot in the probe sequence of nHash, growing the table if needed.
+			// The caller constructs the element in the slot and calls commit_insert.
+			[[nodiscard]] size_type prepare_insert(std::size_t const nHash) & MAYTHROW {
+				auto n = find_first_non_full(nHash);
+				if( 0 == m_nGrowthLeft && flat_hash_detail::c_ctrlDeleted != m_pctrl[n] ) {
+					// Drop the tombstones if they make up a large part of the table, otherwise grow.
+					resize(0 < m_nCapacity && m_nSize * 32 <= m_nCapacity * 25 ? m_nCapacity : flat_hash_detail::growth_to_capacity(m_nSize + 1)); // MAYTHROW
+					n = find_first_non_full(nHash);
+				}
+				return n;
+			}
+
+			void commit_insert(size_type const n, std::size_t const nHash) & noexcept {
+				if( flat_hash_detail::c_ctrlEmpty == m_pctrl[n] ) {
+					_ASSERTDEBUG(0 < m_nGrowthLeft);
+					--m_nGrowthLeft;
+				}
+				set_ctrl(n, flat_hash_detail::h2(nHash));
+				++m_nSize;
+			}
+
+			[[nodiscard]] size_type find_first_non_full(std::size_t const nHash) const& noexcept {
+				flat_hash_detail::probe_seq seq(flat_hash_detail::h1(nHash), m_nCapacity);
+				for(;;) {
+					if( auto const nMask = flat_hash_detail::group(m_pctrl + seq.offset()).match_empty_or_deleted() ) {
+						return seq.offset(tc::explicit_cast<std::size_t>(std::countr_zero(nMask)));
+					}
+					seq.next();
+				}
+			}
+
+			// The first c_nGroupWidth-1 control bytes are cloned after the sentinel, so that groups can be loaded at every slot.
+			void set_ctrl(size_type const n, ctrl_t const ctrl) & noexcept {
+				m_pctrl[n] = ctrl;
+				if( n < flat_hash_detail::c_nGroupWidth - 1 ) {
+					m_pctrl[m_nCapacity + 1 + n] = ctrl;
+				}
+			}
+
+			static constexpr size_type ctrl_size(size_type const nCapacity) noexcept {
+				return nCapacity + flat_hash_detail::c_nGroupWidth;
+			}
+
+			void resize(size_type const nCapacity) & MAYTHROW {
+				_ASSERTDEBUG(std::has_single_bit(nCapacity + 1) && flat_hash_detail::c_nGroupWidth - 1 <= nCapacity && m_nSize <= flat_hash_detail::capacity_to_growth(nCapacity));
+				ctrl_allocator_type allocctrl(m_alloc);
+				auto* const pctrl = std::allocator_traits<ctrl_allocator_type>::allocate(allocctrl, ctrl_size(nCapacity)); // MAYTHROW
+				slot_type* pslot;
+				try {
+					pslot = slot_traits::allocate(m_alloc, nCapacity); // MAYTHROW
+				} catch(...) {
+					std::allocator_traits<ctrl_allocator_type>::deallocate(allocctrl, pctrl, ctrl_size(nCapacity));
+					throw;
+				}
+				std::fill_n(pctrl, ctrl_size(nCapacity), flat_hash_detail::c_ctrlEmpty);
+				pctrl[nCapacity] = flat_hash_detail::c_ctrlSentinel;
+
+				auto const pctrlOld = m_pctrl;
+				auto const pslotOld = m_pslot;
+				auto const nCapacityOld = m_nCapacity;
+				m_pctrl = pctrl;
+				m_pslot = pslot;
+				m_nCapacity = nCapacity;
+				for( size_type nOld = 0; nOld < nCapacityOld; ++nOld ) {
+					if( flat_hash_detail::is_full(pctrlOld[nOld]) ) {
+						auto const nHash = hash_of(Policy::key(Policy::element(pslotOld[nOld]))); // hashing the stored keys again is assumed not to throw
+						auto const n = find_first_non_full(nHash);
+						set_ctrl(n, flat_hash_detail::h2(nHash));
+						Policy::transfer(m_alloc, m_pslot + n, pslotOld + nOld);
+					}
+				}
+				m_nGrowthLeft = flat_hash_detail::capacity_to_growth(m_nCapacity) - m_nSize;
+				if( 0 < nCapacityOld ) {
+					std::allocator_traits<ctrl_allocator_type>::deallocate(allocctrl, pctrlOld, ctrl_size(nCapacityOld));
+					slot_traits::deallocate(m_alloc, pslotOld, nCapacityOld);
+				}
+			}
+
+			void destroy_and_deallocate() & noexcept {
+				if( 0 < m_nCapacity ) {
+					if constexpr( !std::is_trivially_destructible<value_type>::value ) {
+						for( size_type n = 0; n < m_nCapacity; ++n ) {
+							if( flat_hash_detail::is_full(m_pctrl[n]) ) slot_traits::destroy(m_alloc, std::addressof(Policy::element(m_pslot[n])));
+						}
+					}
+					ctrl_allocator_type allocctrl(m_alloc);
+					std::allocator_traits<ctrl_allocator_type>::deallocate(allocctrl, m_pctrl, ctrl_size(m_nCapacity));
+					slot_traits::deallocate(m_alloc, m_pslot, m_nCapacity);
+				}
+			}
+
+			ctrl_t* m_pctrl = flat_hash_detail::empty_table_ctrl();
+			slot_type* m_pslot = nullptr;
+			size_type m_nCapacity = 0; // 0 or 2^n-1
+			size_type m_nSize = 0;
+			size_type m_nGrowthLeft = 0; // elements that can be inserted into empty slots before the table must grow
+			Hash m_hash;
+			KeyEqual m_equal;
+			slot_allocator_type m_alloc;
+		};
+
+		template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+		struct flat_hash_set final : flat_hash_table<flat_hash_detail::set_policy<Key>, Hash, KeyEqual, Alloc> {
+			using flat_hash_table<flat_hash_detail::set_policy<Key>, Hash, KeyEqual, Alloc>::flat_hash_table;
+		};
+
+		template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+		struct flat_hash_map final : flat_hash_table<flat_hash_detail::map_policy<Key, T>, Hash, KeyEqual, Alloc> {
+		private:
+			using base_ = flat_hash_table<flat_hash_detail::map_policy<Key, T>, Hash, KeyEqual, Alloc>;
+		public:
+			using base_::base_;
+			using mapped_type = T;
+
+			// Like std::unordered_map::try_emplace: the mapped value is only constructed if key is not present yet.
+			template<typename K, typename... Args> requires std::is_same<std::remove_cvref_t<K>, Key>::value
+			std::pair<typename base_::iterator, bool> try_emplace(K&& key, Args&&... args) & MAYTHROW {
+				return this->emplace_with_key(key, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)); // MAYTHROW
+			}
+
+			template<typename K> requires std::is_same<std::remove_cvref_t<K>, Key>::value
+			T& operator[](K&& key) & MAYTHROW {
+				return try_emplace(std::forward<K>(key)).first->second; // MAYTHROW
+			}
+		};
+	}
+
+	template<typename Key, typename Hash = flat_hash_detail::default_hash<Key>, typename KeyEqual = flat_hash_detail::default_key_equal, typename Alloc = std::allocator<Key>>
+	using flat_hash_set = no_adl::flat_hash_set<Key, Hash, KeyEqual, Alloc>;
+
+	template<typename Key, typename T, typename Hash = flat_hash_detail::default_hash<Key>, typename KeyEqual = flat_hash_detail::default_key_equal, typename Alloc = std::allocator<std::pair<Key const, T>>>
+	using flat_hash_map = no_adl::flat_hash_map<Key, T, Hash, KeyEqual, Alloc>;
+}
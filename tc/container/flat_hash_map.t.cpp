@@ -0,0 +1,86 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/algorithm.h"
+#include "../range/iota_range.h"
+#include "flat_hash_map.h"
+#include "insert.h"
+
+#include <string>
+
+UNITTESTDEF(flat_hash_set) {
+	tc::flat_hash_set<int> setn;
+	_ASSERT(setn.empty());
+	_ASSERT(!tc::cont_find<tc::return_bool>(setn, 1));
+	_ASSERT(tc::begin(setn) == tc::end(setn));
+
+	for( int n = 0; n < 10000; ++n ) {
+		tc::cont_must_emplace(setn, n * 7);
+	}
+	_ASSERTEQUAL(setn.size(), 10000);
+	for( int n = 0; n < 10000; ++n ) {
+		_ASSERT(tc::cont_find<tc::return_bool>(setn, n * 7));
+		_ASSERT(!tc::cont_find<tc::return_bool>(setn, n * 7 + 1));
+	}
+	_ASSERT(!tc::cont_try_emplace(setn, 7).second);
+	_ASSERTEQUAL(tc::size(setn), 10000);
+
+	long long nSum = 0;
+	tc::for_each(setn, [&](int const n) noexcept { nSum += n; });
+	_ASSERTEQUAL(nSum, 7ll * 10000 * 9999 / 2);
+
+	// erasing and reinserting reuses deleted slots without unbounded growth
+	auto const nCapacity = setn.capacity();
+	for( int nRound = 0; nRound < 10; ++nRound ) {
+		for( int n = 0; n < 5000; ++n ) _ASSERTEQUAL(setn.erase(n * 7), 1);
+		for( int n = 0; n < 5000; ++n ) tc::cont_must_emplace(setn, n * 7);
+	}
+	_ASSERTEQUAL(setn.size(), 10000);
+	_ASSERTEQUAL(setn.capacity(), nCapacity);
+
+	auto setnCopy = setn;
+	_ASSERT(setnCopy == setn);
+	setnCopy.erase(tc::begin(setnCopy));
+	_ASSERT(setnCopy != setn);
+
+	auto const setnConverted = tc::explicit_cast<tc::flat_hash_set<int>>(tc::iota(0, 100));
+	_ASSERTEQUAL(setnConverted.size(), 100);
+	_ASSERT(tc::cont_find<tc::return_bool>(setnConverted, 99));
+}
+
+UNITTESTDEF(flat_hash_map) {
+	tc::flat_hash_map<std::string, int> mapstrn;
+	for( int n = 0; n < 1000; ++n ) {
+		_ASSERT(mapstrn.try_emplace(std::to_string(n), n).second);
+	}
+	_ASSERTEQUAL(mapstrn.size(), 1000);
+	for( int n = 0; n < 1000; ++n ) {
+		auto const it = tc::cont_find<tc::return_element_or_null>(mapstrn, std::to_string(n));
+		_ASSERT(it);
+		_ASSERTEQUAL(it->second, n);
+	}
+	_ASSERT(!tc::cont_try_emplace(mapstrn, std::string("5"), 6).second);
+	_ASSERTEQUAL(mapstrn[std::string("5")], 5);
+	++mapstrn[std::string("1000")];
+	_ASSERT(!mapstrn.emplace(std::make_pair(std::string("5"), 6)).second); // element constructed to find its key
+	_ASSERT(mapstrn.insert(std::make_pair(std::string("1001"), 1001)).second);
+	_ASSERT(mapstrn.erase(std::string("1001")));
+
+	// keys survive rehashing
+	tc::flat_hash_map<std::string, int> mapstrnMoved(tc_move(mapstrn));
+	_ASSERT(mapstrn.empty());
+	mapstrnMoved.reserve(100000);
+	_ASSERTEQUAL(mapstrnMoved.size(), 1001);
+	_ASSERTEQUAL(mapstrnMoved[std::string("999")], 999);
+	_ASSERTEQUAL(mapstrnMoved[std::string("1000")], 1);
+
+	tc::filter_inplace(mapstrnMoved, [](auto const& pairstrn) noexcept { return 0 == pairstrn.second % 2; });
+	_ASSERTEQUAL(mapstrnMoved.size(), 500);
+	_ASSERT(tc::all_of(mapstrnMoved, [](auto const& pairstrn) noexcept { return 0 == pairstrn.second % 2; }));
+}
@@ -0,0 +1,401 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/type_traits.h"
+#include "../base/tag_type.h"
+#include "../base/tc_move.h"
+#include "../algorithm/algorithm.h"
+#include "../algorithm/partition_iterator.h"
+#include "container.h"
+#include "cont_reserve.h"
+#include "insert.h"
+
+#include <compare>
+#include <tuple>
+#include <utility>
+
+namespace tc {
+	DEFINE_TAG_TYPE(sorted_unique_tag) // the elements are already strictly ordered
+
+	namespace flat_map_detail {
+		template<typename Key>
+		struct set_policy final {
+			using key_type = Key;
+			using value_type = Key;
+
+			static constexpr bool c_bConstElements = true; // elements are keys
+
+			[[nodiscard]] static constexpr key_type const& key(value_type const& val) noexcept { return val; }
+		};
+
+		template<typename Key, typename T>
+		struct map_policy final {
+			using key_type = Key;
+			using value_type = std::pair<Key, T>;
+
+			static constexpr bool c_bConstElements = false; // keys must not be modified though
+
+			[[nodiscard]] static constexpr key_type const& key(value_type const& val) noexcept { return val.first; }
+		};
+
+		// Compares elements and keys by key.
+		template<typename Policy, typename Less>
+		struct value_less final {
+			Less const& m_less;
+
+			template<typename Lhs, typename Rhs>
+			[[nodiscard]] constexpr bool operator()(Lhs const& lhs, Rhs const& rhs) const& MAYTHROW {
+				return tc::invoke(m_less, key_of(lhs), key_of(rhs)); // MAYTHROW
+			}
+
+		private:
+			static constexpr auto const& key_of(typename Policy::value_type const& val) noexcept { return Policy::key(val); }
+			template<typename K> requires (!std::is_same<K, typename Policy::value_type>::value)
+			static constexpr K const& key_of(K const& key) noexcept { return key; }
+		};
+
+		template<typename FlatTree>
+		struct range_filter;
+	}
+
+	namespace no_adl {
+		// Set or map stored as a vector sorted by Less. Lookups are binary searches on contiguous memory and the elements
+		// need no nodes, which makes it the better choice for read-mostly tables. Single insertions and erasures move the
+		// elements behind them, so prefer building from a whole range and merge_sorted for batches.
+		// As with tc::vector, insertions and erasures invalidate iterators.
+		template<typename Policy, typename Less, typename Cont>
+		struct flat_tree {
+			using key_type = typename Policy::key_type;
+			using value_type = typename Policy::value_type;
+			using key_compare = Less;
+			using container_type = Cont;
+			using size_type = typename Cont::size_type;
+			using difference_type = typename Cont::difference_type;
+			using reference = typename Cont::reference;
+			using const_reference = typename Cont::const_reference;
+			using iterator = std::conditional_t<Policy::c_bConstElements, typename Cont::const_iterator, typename Cont::iterator>;
+			using const_iterator = typename Cont::const_iterator;
+
+			static_assert( std::is_same<tc::range_value_t<Cont>, value_type>::value );
+
+			flat_tree() = default;
+
+			explicit flat_tree(Less less) noexcept
+				: m_less(tc_move(less))
+			{}
+
+			// Bulk construction in O(n log n): the elements are sorted and, of equivalent elements, the first is kept.
+			explicit flat_tree(Cont cont, Less less = Less()) MAYTHROW
+				: m_cont(tc_move(cont))
+				, m_less(tc_move(less))
+			{
+				tc::stable_sort_unique_inplace(m_cont, value_less()); // MAYTHROW
+			}
+
+			// Bulk construction in O(1) from elements which are already sorted and unique.
+			flat_tree(tc::sorted_unique_tag_t, Cont cont, Less less = Less()) noexcept
+				: m_cont(tc_move(cont))
+				, m_less(tc_move(less))
+			{
+				_ASSERTDEBUG( tc::is_strictly_sorted(m_cont, value_less()) );
+			}
+
+			template<typename It>
+			flat_tree(It itBegin, It itEnd, Less less = Less()) MAYTHROW
+				: flat_tree(Cont(itBegin, itEnd), tc_move(less))
+			{}
+
+			[[nodiscard]] const_iterator begin() const& noexcept { return tc::begin(m_cont); }
+			[[nodiscard]] const_iterator end() const& noexcept { return tc::end(m_cont); }
+			[[nodiscard]] size_type size() const& noexcept { return m_cont.size(); }
+			[[nodiscard]] bool empty() const& noexcept { return m_cont.empty(); }
+			[[nodiscard]] key_compare key_comp() const& noexcept { return m_less; }
+			[[nodiscard]] flat_map_detail::value_less<Policy, Less> value_less() const& noexcept { return {m_less}; }
+
+			[[nodiscard]] Cont const& container() const& noexcept { return m_cont; }
+			[[nodiscard]] Cont extract() && noexcept { return tc_move(m_cont); }
+
+			void clear() & noexcept { m_cont.clear(); }
+			void swap(flat_tree& other) & noexcept {
+				using std::swap;
+				swap(m_cont, other.m_cont);
+				swap(m_less, other.m_less);
+			}
+			void reserve(size_type const n) & MAYTHROW { tc::cont_reserve(m_cont, n); }
+
+			template<typename K>
+			[[nodiscard]] iterator lower_bound(K const& key) & noexcept {
+				return tc::iterator::lower_bound(tc::begin(m_cont), tc::end(m_cont), key, value_less());
+			}
+			template<typename K>
+			[[nodiscard]] const_iterator lower_bound(K const& key) const& noexcept {
+				return tc::iterator::lower_bound(tc::begin(m_cont), tc::end(m_cont), key, value_less());
+			}
+			template<typename K>
+			[[nodiscard]] iterator upper_bound(K const& key) & noexcept {
+				return tc::iterator::upper_bound(tc::begin(m_cont), tc::end(m_cont), key, value_less());
+			}
+			template<typename K>
+			[[nodiscard]] const_iterator upper_bound(K const& key) const& noexcept {
+				return tc::iterator::upper_bound(tc::begin(m_cont), tc::end(m_cont), key, value_less());
+			}
+
+			template<typename K>
+			[[nodiscard]] iterator find(K const& key) & noexcept {
+				auto const it = lower_bound(key);
+				return tc::end(m_cont) == it || value_less()(key, *it) ? tc::end(m_cont) : it;
+			}
+			template<typename K>
+			[[nodiscard]] const_iterator find(K const& key) const& noexcept {
+				return tc::as_mutable(*this).find(key);
+			}
+			template<typename K>
+			[[nodiscard]] bool contains(K const& key) const& noexcept {
+				return end() != find(key);
+			}
+			template<typename K>
+			[[nodiscard]] size_type count(K const& key) const& noexcept {
+				return contains(key) ? 1 : 0;
+			}
+
+			template<typename... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) & MAYTHROW {
+				value_type val(std::forward<Args>(args)...); // MAYTHROW
+				auto const it = lower_bound(Policy::key(val));
+				if( tc::end(m_cont) != it && !value_less()(val, *it) ) {
+					return std::make_pair(it, false);
+				} else {
+					return std::make_pair(NOBADALLOC(m_cont.emplace(it, tc_move(val))), true); // MAYTHROW
+				}
+			}
+
+			// If itHint is the position of the new element, e.g., when inserting in ascending order, no binary search is needed.
+			// Unlike with node-based containers, the insertion invalidates itHint. If itHint is an lvalue, it is therefore
+			// updated to point behind the returned element, as tc::cont_must_emplace_before expects.
+			template<typename... Args>
+			iterator emplace_hint(const_iterator& itHint, Args&&... args) & MAYTHROW {
+				value_type val(std::forward<Args>(args)...); // MAYTHROW
+				iterator it;
+				if( (tc::begin(m_cont) == itHint || value_less()(*tc_modified(itHint, --_), val)) && (tc::end(m_cont) == itHint || value_less()(val, *itHint)) ) {
+					it = NOBADALLOC(m_cont.emplace(itHint, tc_move(val))); // MAYTHROW
+				} else {
+					it = emplace(tc_move(val)).first; // MAYTHROW
+				}
+				itHint = tc_modified(it, ++_);
+				return it;
+			}
+			template<typename... Args>
+			iterator emplace_hint(const_iterator&& itHint, Args&&... args) & MAYTHROW {
+				return emplace_hint(itHint, std::forward<Args>(args)...); // MAYTHROW
+			}
+
+			std::pair<iterator, bool> insert(value_type const& val) & MAYTHROW {
+				return emplace(val); // MAYTHROW
+			}
+			std::pair<iterator, bool> insert(value_type&& val) & MAYTHROW {
+				return emplace(tc_move(val)); // MAYTHROW
+			}
+
+			// Inserts the elements of rng, which must be sorted by Less, in O(n+m). Elements equivalent to elements already
+			// in the container or to earlier elements of rng are not inserted.
+			template<typename Rng>
+			void merge_sorted(Rng&& rng) & MAYTHROW {
+				_ASSERTDEBUG(tc::is_sorted(rng, value_less()));
+				Cont contMerged;
+				if constexpr( tc::has_size<Rng> ) {
+					tc::cont_reserve(contMerged, m_cont.size() + tc::size_raw(rng)); // MAYTHROW
+				} else {
+					tc::cont_reserve(contMerged, m_cont.size()); // MAYTHROW
+				}
+				tc::interleave_2(
+					m_cont,
+					rng,
+					[&](auto const& lhs, auto const& rhs) MAYTHROW {
+						if( value_less()(lhs, rhs) ) { // MAYTHROW
+							return std::weak_ordering::less;
+						} else if( value_less()(rhs, lhs) ) { // MAYTHROW
+							return std::weak_ordering::greater;
+						} else {
+							return std::weak_ordering::equivalent;
+						}
+					},
+					[&](value_type& val) MAYTHROW { tc::cont_emplace_back(contMerged, tc_move_always(val)); },
+					[&](auto&& val) MAYTHROW {
+						if( tc::empty(contMerged) || value_less()(tc::back(contMerged), val) ) { // MAYTHROW
+							tc::cont_emplace_back(contMerged, tc_move_if_owned(val)); // MAYTHROW
+						}
+					},
+					[&](value_type& val, tc::unused) MAYTHROW { tc::cont_emplace_back(contMerged, tc_move_always(val)); }
+				); // MAYTHROW
+				m_cont = tc_move(contMerged);
+			}
+
+			iterator erase(const_iterator const it) & noexcept {
+				return m_cont.erase(it);
+			}
+			iterator erase(const_iterator const itBegin, const_iterator const itEnd) & noexcept {
+				return m_cont.erase(itBegin, itEnd);
+			}
+			template<typename K> requires (!std::is_convertible<K const&, const_iterator>::value)
+			size_type erase(K const& key) & noexcept {
+				if( auto const it = find(key); tc::end(m_cont) != it ) {
+					erase(it);
+					return 1;
+				} else {
+					return 0;
+				}
+			}
+
+			[[nodiscard]] friend bool operator==(flat_tree const& lhs, flat_tree const& rhs) noexcept {
+				return lhs.m_cont == rhs.m_cont;
+			}
+
+		protected:
+			Cont m_cont;
+			Less m_less;
+
+		private:
+			template<typename FlatTree>
+			friend struct flat_map_detail::range_filter;
+		};
+
+		template<typename Key, typename Less, typename Cont>
+		struct flat_set final : flat_tree<flat_map_detail::set_policy<Key>, Less, Cont> {
+			using flat_tree<flat_map_detail::set_policy<Key>, Less, Cont>::flat_tree;
+		};
+
+		template<typename Key, typename T, typename Less, typename Cont>
+		struct flat_map final : flat_tree<flat_map_detail::map_policy<Key, T>, Less, Cont> {
+		private:
+			using base_ = flat_tree<flat_map_detail::map_policy<Key, T>, Less, Cont>;
+		public:
+			using base_::base_;
+			using mapped_type = T;
+			using typename base_::iterator;
+
+			[[nodiscard]] iterator begin() & noexcept { return tc::begin(this->m_cont); }
+			[[nodiscard]] iterator end() & noexcept { return tc::end(this->m_cont); }
+			using base_::begin;
+			using base_::end;
+
+			// The mapped value is only constructed if key is not present yet.
+			template<typename K, typename... Args>
+			std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) & MAYTHROW {
+				auto const it = this->lower_bound(key);
+				if( tc::end(this->m_cont) != it && !this->value_less()(key, *it) ) {
+					return std::make_pair(it, false);
+				} else {
+					return std::make_pair(NOBADALLOC(this->m_cont.emplace(it, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...))), true); // MAYTHROW
+				}
+			}
+
+			template<typename K>
+			T& operator[](K&& key) & MAYTHROW {
+				return try_emplace(std::forward<K>(key)).first->second; // MAYTHROW
+			}
+		};
+	}
+
+	template<typename Key, typename Less = tc::less_key, typename Cont = tc::vector<Key>>
+	using flat_set = no_adl::flat_set<Key, Less, Cont>;
+
+	template<typename Key, typename T, typename Less = tc::less_key, typename Cont = tc::vector<std::pair<Key, T>>>
+	using flat_map = no_adl::flat_map<Key, T, Less, Cont>;
+
+	template<typename T>
+	concept flat_tree_instance = tc::instance<T, no_adl::flat_set> || tc::instance<T, no_adl::flat_map>;
+
+	namespace flat_map_detail {
+		// O(n log n) instead of inserting element by element.
+		template<typename TTarget, typename Rng>
+		TTarget from_range(Rng&& rng) MAYTHROW {
+			auto cont = tc::explicit_cast<typename TTarget::container_type>(std::forward<Rng>(rng)); // MAYTHROW
+			auto const nSize = tc::size_raw(cont);
+			TTarget flat(tc_move(cont)); // MAYTHROW
+			_ASSERTEQUAL(tc::size_raw(flat), nSize); // like tc::cont_must_insert_range, no element may be dropped
+			return flat;
+		}
+	}
+
+	namespace explicit_convert_adl {
+		template<typename Key, typename Less, typename Cont, typename Rng>
+		tc::flat_set<Key, Less, Cont> explicit_convert_impl(adl_tag_t, tc::type::identity<tc::flat_set<Key, Less, Cont>>, Rng&& rng) MAYTHROW {
+			return flat_map_detail::from_range<tc::flat_set<Key, Less, Cont>>(std::forward<Rng>(rng)); // MAYTHROW
+		}
+
+		template<typename Key, typename T, typename Less, typename Cont, typename Rng>
+		tc::flat_map<Key, T, Less, Cont> explicit_convert_impl(adl_tag_t, tc::type::identity<tc::flat_map<Key, T, Less, Cont>>, Rng&& rng) MAYTHROW {
+			return flat_map_detail::from_range<tc::flat_map<Key, T, Less, Cont>>(std::forward<Rng>(rng)); // MAYTHROW
+		}
+	}
+
+	namespace flat_map_detail {
+		// Filtering keeps the order of the remaining elements, so the underlying container is filtered by moving elements.
+		// The node-based tc::range_filter, which would otherwise be chosen because of lower_bound, would erase elements one
+		// by one and invalidate the iterators of tc::filter_inplace.
+		template<typename FlatTree>
+		struct range_filter : tc::noncopyable {
+			using iterator = typename FlatTree::iterator;
+			using const_iterator = iterator; // no deep constness (analog to subrange)
+
+		private:
+			using container_type = typename FlatTree::container_type;
+			container_type& m_cont;
+			tc::range_filter<container_type> m_rngfilterCont;
+
+			[[nodiscard]] tc::iterator_t<container_type> mutable_iterator(iterator const it) const& noexcept {
+				return tc::begin(m_cont) + (it - tc::begin(m_cont));
+			}
+
+		public:
+			explicit range_filter(FlatTree& flat) noexcept
+				: m_cont(flat.m_cont)
+				, m_rngfilterCont(m_cont)
+			{}
+
+			range_filter(FlatTree& flat, iterator const itStart) noexcept
+				: m_cont(flat.m_cont)
+				, m_rngfilterCont(m_cont, mutable_iterator(itStart))
+			{}
+
+			void keep(iterator const it) & noexcept {
+				m_rngfilterCont.keep(mutable_iterator(it));
+			}
+
+			[[nodiscard]] iterator begin() const& noexcept {
+				return tc::begin(m_rngfilterCont);
+			}
+
+			[[nodiscard]] iterator end() const& noexcept {
+				return tc::end(m_rngfilterCont);
+			}
+
+			void pop_back() & noexcept {
+				m_rngfilterCont.pop_back();
+			}
+		};
+	}
+
+	template<typename Key, typename Less, typename Cont>
+	struct range_filter<no_adl::flat_set<Key, Less, Cont>> : flat_map_detail::range_filter<no_adl::flat_set<Key, Less, Cont>> {
+		using flat_map_detail::range_filter<no_adl::flat_set<Key, Less, Cont>>::range_filter;
+	};
+
+	template<typename Key, typename T, typename Less, typename Cont>
+	struct range_filter<no_adl::flat_map<Key, T, Less, Cont>> : flat_map_detail::range_filter<no_adl::flat_map<Key, T, Less, Cont>> {
+		using flat_map_detail::range_filter<no_adl::flat_map<Key, T, Less, Cont>>::range_filter;
+	};
+
+	// Searches by key with the order of the container.
+	template<typename RangeReturn, typename Rng, typename T> requires tc::flat_tree_instance<tc::decay_t<Rng>>
+	[[nodiscard]] decltype(auto) binary_find_unique(Rng&& rng, T const& t) noexcept {
+		return tc::binary_find_unique<RangeReturn>(std::forward<Rng>(rng), t, rng.value_less());
+	}
+}
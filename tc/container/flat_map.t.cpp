@@ -0,0 +1,70 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "../range/iota_range.h"
+#include "../range/transform.h"
+#include "flat_map.h"
+
+#include <string>
+
+UNITTESTDEF(flat_set) {
+	auto setn = tc::explicit_cast<tc::flat_set<int>>(tc::transform(tc::iota(0, 100), [](int const n) noexcept { return (n * 37) % 100; }));
+	_ASSERTEQUAL(setn.size(), 100);
+	_ASSERT(tc::is_strictly_sorted(setn));
+	_ASSERT(tc::cont_find<tc::return_bool>(setn, 42));
+	_ASSERT(!tc::cont_find<tc::return_bool>(setn, 100));
+	_ASSERTEQUAL(tc::binary_find_unique<tc::return_element>(setn, 42), tc::begin(setn) + 42);
+
+	_ASSERT(!tc::cont_try_emplace(setn, 5).second);
+	tc::cont_must_emplace(setn, -1);
+	tc::cont_emplace_back(setn, 100);
+	_ASSERTEQUAL(setn.size(), 102);
+	_ASSERTEQUAL(tc::front(setn), -1);
+	_ASSERTEQUAL(tc::back(setn), 100);
+
+	// batches are merged, skipping elements which are already present or repeated
+	setn.merge_sorted(tc::vector<int>{-3, -1, 50, 150, 150, 200});
+	_ASSERTEQUAL(setn.size(), 105);
+	_ASSERT(tc::is_strictly_sorted(setn));
+	_ASSERTEQUAL(tc::front(setn), -3);
+	_ASSERTEQUAL(tc::back(setn), 200);
+
+	_ASSERTEQUAL(setn.erase(150), 1);
+	_ASSERTEQUAL(setn.erase(150), 0);
+	tc::filter_inplace(setn, [](int const n) noexcept { return 0 <= n && n < 10; });
+	_ASSERT(tc::equal(setn, tc::iota(0, 10)));
+}
+
+UNITTESTDEF(flat_map) {
+	tc::flat_map<std::string, int> mapstrn(tc::vector<std::pair<std::string, int>>{{"b", 2}, {"a", 1}, {"c", 3}, {"a", 4}});
+	_ASSERTEQUAL(mapstrn.size(), 3);
+	_ASSERTEQUAL(tc::front(mapstrn).second, 1); // of equivalent elements, the first is kept
+
+	// transparent lookup with tc::less_key
+	_ASSERT(tc::cont_find<tc::return_bool>(mapstrn, "b"));
+	_ASSERTEQUAL(tc::binary_find_unique<tc::return_element>(mapstrn, std::string("c"))->second, 3);
+	_ASSERT(!tc::binary_find_unique<tc::return_bool>(mapstrn, std::string("d")));
+
+	_ASSERT(!mapstrn.try_emplace(std::string("a"), 5).second);
+	mapstrn[std::string("d")] = 4;
+	++mapstrn[std::string("a")];
+	_ASSERTEQUAL(mapstrn.size(), 4);
+	_ASSERTEQUAL(tc::cont_find<tc::return_element>(mapstrn, "a")->second, 2);
+
+	mapstrn.merge_sorted(tc::vector<std::pair<std::string, int>>{{"a", 0}, {"e", 5}});
+	_ASSERTEQUAL(mapstrn.size(), 5);
+	_ASSERTEQUAL(tc::cont_find<tc::return_element>(mapstrn, "a")->second, 2);
+	_ASSERTEQUAL(tc::back(mapstrn).second, 5);
+
+	tc::filter_inplace(mapstrn, [](auto const& pairstrn) noexcept { return 0 != pairstrn.second % 2; });
+	_ASSERTEQUAL(mapstrn.size(), 2);
+	_ASSERTEQUAL(tc::front(mapstrn).first, "c");
+	_ASSERTEQUAL(tc::back(mapstrn).first, "e");
+}
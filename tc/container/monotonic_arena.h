@@ -0,0 +1,54 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/noncopyable.h"
+#include "container.h"
+
+#include <memory_resource>
+
+namespace tc {
+	namespace no_adl {
+		// Arena for temporaries which die together, e.g., all temporaries of a request: allocation bumps a pointer into the current chunk,
+		// deallocation is a no-op, and all memory is returned to the upstream resource at once by release() or the destructor.
+		// Containers use it through allocator(), e.g., tc::make_vector(arena.allocator(), rng).
+		struct monotonic_arena final : tc::nonmovable {
+			monotonic_arena() noexcept
+				: m_resource(std::pmr::get_default_resource())
+			{}
+
+			explicit monotonic_arena(std::size_t const nInitialChunkSize, std::pmr::memory_resource* const presourceUpstream = std::pmr::get_default_resource()) noexcept
+				: m_resource(nInitialChunkSize, presourceUpstream)
+			{}
+
+			[[nodiscard]] std::pmr::memory_resource* resource() & noexcept {
+				return std::addressof(m_resource);
+			}
+
+			template<typename T = std::byte>
+			[[nodiscard]] std::pmr::polymorphic_allocator<T> allocator() & noexcept {
+				return std::pmr::polymorphic_allocator<T>(resource());
+			}
+
+			// All containers allocated from the arena must have been destroyed.
+			void release() & noexcept {
+				m_resource.release();
+			}
+
+		private:
+			std::pmr::monotonic_buffer_resource m_resource;
+		};
+	}
+	using no_adl::monotonic_arena;
+
+	namespace pmr {
+		template<typename T>
+		using vector = tc::vector<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
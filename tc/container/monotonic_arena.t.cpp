@@ -0,0 +1,53 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/iota_range.h"
+#include "../range/filter_adaptor.h"
+#include "../algorithm/append.h"
+#include "../algorithm/equal.h"
+#include "monotonic_arena.h"
+
+namespace {
+	struct counting_resource final : std::pmr::memory_resource {
+		int m_nAllocations = 0;
+		int m_nDeallocations = 0;
+	private:
+		void* do_allocate(std::size_t const nBytes, std::size_t const nAlignment) override {
+			++m_nAllocations;
+			return std::pmr::new_delete_resource()->allocate(nBytes, nAlignment);
+		}
+		void do_deallocate(void* const p, std::size_t const nBytes, std::size_t const nAlignment) override {
+			++m_nDeallocations;
+			std::pmr::new_delete_resource()->deallocate(p, nBytes, nAlignment);
+		}
+		bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+			return this == std::addressof(other);
+		}
+	};
+}
+
+UNITTESTDEF(monotonic_arena) {
+	counting_resource resource;
+	{
+		tc::monotonic_arena arena(1 << 16, std::addressof(resource));
+		for( int n = 0; n < 100; ++n ) {
+			auto const vecn = tc::make_vector(arena.allocator(), tc::filter(tc::iota(0, 100), [](int const n) noexcept { return 0 == n % 3; }));
+			STATICASSERTSAME((decltype(vecn)), (tc::pmr::vector<int> const));
+			_ASSERTEQUAL(tc::size(vecn), 34);
+			_ASSERTEQUAL(vecn.get_allocator().resource(), arena.resource());
+		}
+		auto vecn = tc::explicit_cast<tc::pmr::vector<int>>(std::allocator_arg, arena.allocator<int>(), tc::iota(0, 3), tc::iota(3, 5));
+		_ASSERT(tc::equal(vecn, tc::iota(0, 5)));
+		tc::append(vecn, tc::iota(5, 1000));
+		_ASSERT(tc::equal(vecn, tc::iota(0, 1000)));
+		_ASSERTEQUAL(resource.m_nDeallocations, 0);
+	}
+	_ASSERT(0 < resource.m_nAllocations);
+	_ASSERTEQUAL(resource.m_nAllocations, resource.m_nDeallocations);
+}
@@ -23,6 +23,9 @@
 #include "range/empty_range.h"
 #include "interval_types.h"
 
+#include <array>
+#include <cstdint>
+
 namespace tc {
 	DEFINE_TAG_TYPE(enumset_from_underlying_tag)
 	DEFINE_TAG_TYPE(union_tag)
@@ -35,6 +38,156 @@ namespace tc {
 		constexpr tc::enumset<EnumSub> explicit_convert_impl(adl_tag_t, tc::type::identity<tc::enumset<EnumSub>>, tc::enumset<EnumSuper> const setesuper) noexcept;
 	}
 
+	namespace enumset_detail {
+		using word_t = std::uint64_t;
+		inline constexpr int c_nWordBits = std::numeric_limits<word_t>::digits;
+
+		// Bits of enumsets with more than 64 enumerators. Unlike boost::multiprecision numbers, all operations are plain loops
+		// over the words, which the compiler can vectorize, and searching for set bits skips zero words.
+		template<std::size_t nWords>
+		struct word_array final {
+			std::array<word_t, nWords> m_an{};
+
+			constexpr word_array& operator&=(word_array const& rhs) & noexcept {
+				for( std::size_t nWord = 0; nWord < nWords; ++nWord ) m_an[nWord] &= rhs.m_an[nWord];
+				return *this;
+			}
+			constexpr word_array& operator|=(word_array const& rhs) & noexcept {
+				for( std::size_t nWord = 0; nWord < nWords; ++nWord ) m_an[nWord] |= rhs.m_an[nWord];
+				return *this;
+			}
+			constexpr word_array& operator^=(word_array const& rhs) & noexcept {
+				for( std::size_t nWord = 0; nWord < nWords; ++nWord ) m_an[nWord] ^= rhs.m_an[nWord];
+				return *this;
+			}
+			friend constexpr word_array operator&(word_array lhs, word_array const& rhs) noexcept {
+				return lhs &= rhs;
+			}
+			constexpr word_array operator~() const& noexcept {
+				word_array bitset;
+				for( std::size_t nWord = 0; nWord < nWords; ++nWord ) bitset.m_an[nWord] = ~m_an[nWord];
+				return bitset;
+			}
+			friend constexpr bool operator==(word_array const& lhs, word_array const& rhs) noexcept = default;
+		};
+
+		template<int nBits, bool bWordArray = c_nWordBits < nBits>
+		struct bitset final {
+			using type = typename tc::integer<nBits>::unsigned_;
+		};
+
+		template<int nBits>
+		struct bitset<nBits, true> final {
+			using type = word_array<(nBits + c_nWordBits - 1) / c_nWordBits>;
+		};
+
+		template<int nBits>
+		using bitset_t = typename bitset<nBits>::type;
+
+		template<typename Bitset>
+		[[nodiscard]] constexpr Bitset lsb_mask(int const nDigits) noexcept {
+			if constexpr( std::is_integral<Bitset>::value ) {
+				if (0 == nDigits) {
+					return 0;
+				} else {
+					_ASSERTE(0 < nDigits);
+					return static_cast<Bitset>(-1)>>(std::numeric_limits<Bitset>::digits - nDigits);
+				}
+			} else {
+				_ASSERTE(0 <= nDigits);
+				Bitset bitset;
+				for( std::size_t nWord = 0; nWord < bitset.m_an.size(); ++nWord ) {
+					int const nDigitsInWord = nDigits - tc::explicit_cast<int>(nWord) * c_nWordBits;
+					bitset.m_an[nWord] = c_nWordBits <= nDigitsInWord ? ~word_t(0) : nDigitsInWord <= 0 ? 0 : (word_t(1) << nDigitsInWord) - 1;
+				}
+				return bitset;
+			}
+		}
+
+		template<typename Bitset>
+		[[nodiscard]] constexpr Bitset single_bit(int const nIndex) noexcept {
+			_ASSERTE(0 <= nIndex);
+			if constexpr( std::is_integral<Bitset>::value ) {
+				return tc::explicit_cast<Bitset>(1) << nIndex;
+			} else {
+				Bitset bitset;
+				bitset.m_an[nIndex / c_nWordBits] = word_t(1) << (nIndex % c_nWordBits);
+				return bitset;
+			}
+		}
+
+		template<typename Bitset>
+		[[nodiscard]] constexpr bool any(Bitset const& bitset) noexcept {
+			if constexpr( std::is_integral<Bitset>::value ) {
+				return 0 != bitset;
+			} else {
+				for( word_t const n : bitset.m_an ) {
+					if( 0 != n ) return true;
+				}
+				return false;
+			}
+		}
+
+		template<typename Bitset>
+		[[nodiscard]] constexpr std::size_t popcount(Bitset const& bitset) noexcept {
+			if constexpr( std::is_integral<Bitset>::value ) {
+				return std::popcount(bitset);
+			} else {
+				std::size_t nCount = 0;
+				for( word_t const n : bitset.m_an ) nCount += std::popcount(n);
+				return nCount;
+			}
+		}
+
+		// Index of the first set bit not below nFrom, or -1 if there is none.
+		template<typename Bitset>
+		[[nodiscard]] constexpr int index_of_first_bit(Bitset const& bitset, int const nFrom) noexcept {
+			if constexpr( std::is_integral<Bitset>::value ) {
+				Bitset const bitsetRemaining = bitset & ~lsb_mask<Bitset>(nFrom);
+				return 0 == bitsetRemaining ? -1 : tc::index_of_least_significant_bit(bitsetRemaining);
+			} else {
+				std::size_t nWord = nFrom / c_nWordBits;
+				if( bitset.m_an.size() <= nWord ) return -1;
+				word_t n = bitset.m_an[nWord] & (~word_t(0) << (nFrom % c_nWordBits));
+				while( 0 == n ) {
+					if( bitset.m_an.size() == ++nWord ) return -1;
+					n = bitset.m_an[nWord];
+				}
+				return tc::explicit_cast<int>(nWord) * c_nWordBits + tc::index_of_least_significant_bit(n);
+			}
+		}
+
+		// Index of the last set bit below nEnd, which must exist.
+		template<typename Bitset>
+		[[nodiscard]] constexpr int index_of_last_bit_below(Bitset const& bitset, int const nEnd) noexcept {
+			if constexpr( std::is_integral<Bitset>::value ) {
+				return tc::index_of_most_significant_bit(tc::explicit_cast<unsigned long>(bitset & lsb_mask<Bitset>(nEnd)));
+			} else {
+				std::size_t nWord = nEnd / c_nWordBits;
+				word_t n = nWord < bitset.m_an.size() ? bitset.m_an[nWord] & ((word_t(1) << (nEnd % c_nWordBits)) - 1) : 0;
+				while( 0 == n ) {
+					_ASSERTE(0 < nWord);
+					n = bitset.m_an[--nWord];
+				}
+				return tc::explicit_cast<int>(nWord) * c_nWordBits + tc::index_of_most_significant_bit(n);
+			}
+		}
+
+		// Moves bit n of bitset to bit n + nShift of the result.
+		template<typename BitsetTarget, typename BitsetSource>
+		[[nodiscard]] constexpr BitsetTarget shifted(BitsetSource const& bitset, int const nShift) noexcept {
+			if constexpr( std::is_integral<BitsetTarget>::value && std::is_integral<BitsetSource>::value ) {
+				return 0 <= nShift ? tc::explicit_cast<BitsetTarget>(tc::explicit_cast<BitsetTarget>(bitset) << nShift) : tc::explicit_cast<BitsetTarget>(bitset >> -nShift);
+			} else {
+				BitsetTarget bitsetTarget{};
+				for( int n = index_of_first_bit(bitset, 0); 0 <= n; n = index_of_first_bit(bitset, n + 1) ) {
+					bitsetTarget |= single_bit<BitsetTarget>(n + nShift);
+				}
+				return bitsetTarget;
+			}
+		}
+	}
+
 	namespace enumset_adl {
 #ifdef TC_PRIVATE
 		template< typename Enum >
@@ -70,53 +223,44 @@ namespace tc {
 			friend void LoadType_impl<>(enumset& sete, CXmlReader& loadhandler) THROW(ExLoadFail);
 #endif
 		private:
-			using bitset_type = typename tc::integer<tc::size(c_rnge)>::unsigned_;
+			using bitset_type = enumset_detail::bitset_t<tc::size(c_rnge)>;
 			PRIVATE_MEMBER_PUBLIC_ACCESSOR(bitset_type, m_bitset);
 
-			template<typename N>
-			static constexpr bitset_type lsb_mask(N const nDigits) noexcept {
-				if (0 == nDigits) {
-					return 0;
-				} else {
-					_ASSERTE(0 < nDigits);
-					return static_cast<bitset_type>(-1)>>(std::numeric_limits<bitset_type>::digits - nDigits);
-				}
-			}
 			static constexpr bitset_type mask() noexcept {
-				return lsb_mask(tc::size(c_rnge));
+				return enumset_detail::lsb_mask<bitset_type>(tc::size(c_rnge));
 			}
 			static constexpr tc_index make_index(int nIndex) {
 				return tc::at<tc::return_element>(c_rnge, tc::explicit_cast<typename boost::range_size<tc::all_values<Enum>>::type>(nIndex));
 			}
 
 		public:
-			constexpr enumset() noexcept : m_bitset(0) {} // makes all bits 0
+			constexpr enumset() noexcept : m_bitset() {} // makes all bits 0
 			constexpr enumset(tc::empty_range) noexcept: enumset() {}
 			constexpr enumset(tc::all_values<Enum>) noexcept : m_bitset(mask()) {}
 			template<typename U>
 			constexpr enumset(enumset_from_underlying_tag_t, U bitset) noexcept : tc_member_init_cast( m_bitset, bitset ) {
-				_ASSERTE( !(m_bitset&~mask()) );
+				_ASSERTE( !enumset_detail::any(m_bitset&~mask()) );
 			}
-			constexpr enumset(Enum e) noexcept : enumset(enumset_from_underlying_tag, tc::explicit_cast<bitset_type>(1) << c_rnge.index_of(e)) {}
+			constexpr enumset(Enum e) noexcept : enumset(enumset_from_underlying_tag, enumset_detail::single_bit<bitset_type>(c_rnge.index_of(e))) {}
 			template<ENABLE_SFINAE>
 			constexpr enumset(tc::interval<SFINAE_TYPE(Enum)> const& intvle) noexcept
-				: enumset(enumset_from_underlying_tag,
-					(tc::explicit_cast<typename tc::integer<tc::size(c_rnge) + 1>::unsigned_>(1) << c_rnge.index_of(intvle[tc::hi]))
-					- (tc::explicit_cast<typename tc::integer<tc::size(c_rnge) + 1>::unsigned_>(1) << c_rnge.index_of(intvle[tc::lo]))
-				)
+				: enumset(enumset_from_underlying_tag, bitset_type(
+					enumset_detail::lsb_mask<bitset_type>(c_rnge.index_of(intvle[tc::hi]))
+					& ~enumset_detail::lsb_mask<bitset_type>(c_rnge.index_of(intvle[tc::lo]))
+				))
 			{
 				_ASSERTE( !intvle.empty_inclusive() );
 			}
 
 			template<typename Rng>
-			constexpr enumset(tc::union_tag_t, Rng&& rng) MAYTHROW : m_bitset(0)
+			constexpr enumset(tc::union_tag_t, Rng&& rng) MAYTHROW : m_bitset()
 			{
 				tc::for_each(std::forward<Rng>(rng), [&](enumset const& sete) noexcept { // MAYTHROW
 					*this |= sete;
 				});
 			}
 			template<typename Func>
-			constexpr enumset(tc::func_tag_t, Func func) MAYTHROW : m_bitset(0) {
+			constexpr enumset(tc::func_tag_t, Func func) MAYTHROW : m_bitset() {
 				// Could be implemented in terms of union_tag constructor and filter, but it wasn't to avoid dependency on filter.
 				tc::for_each(c_rnge, [&](auto e) noexcept {
 					if (tc::explicit_cast<bool>(func(tc::as_const(e)))) { // MAYTHROW
@@ -158,15 +302,19 @@ namespace tc {
 				return lhs==enumset(rhs);
 			}
 			constexpr bool is_singleton() const& noexcept {
-				//return std::has_single_bit(m_bitset);
-				return 0!=m_bitset && 0==(m_bitset & (m_bitset - 1));
+				if constexpr( std::is_integral<bitset_type>::value ) {
+					//return std::has_single_bit(m_bitset);
+					return 0!=m_bitset && 0==(m_bitset & (m_bitset - 1));
+				} else {
+					return 1 == size();
+				}
 			}
 	
 			constexpr std::size_t size() const& noexcept {
-				return std::popcount(m_bitset);
+				return enumset_detail::popcount(m_bitset);
 			}
 			constexpr explicit operator bool() const& noexcept {
-				return 0!=m_bitset;
+				return enumset_detail::any(m_bitset);
 			}
 
 			static constexpr enumset none() noexcept {
@@ -174,7 +322,8 @@ namespace tc {
 			}
 
 			STATIC_FINAL_MOD(constexpr, begin_index)() const& noexcept -> tc_index {
-				return 0 == m_bitset ? this->end_index() : make_index(tc::index_of_least_significant_bit(m_bitset));
+				auto const nIndex = enumset_detail::index_of_first_bit(m_bitset, 0);
+				return nIndex < 0 ? this->end_index() : make_index(nIndex);
 			}
 
 			STATIC_FINAL_MOD(constexpr, end_index)() const& noexcept -> tc_index {
@@ -188,13 +337,24 @@ namespace tc {
 
 			STATIC_FINAL_MOD(constexpr, increment_index)(tc_index& it) const& noexcept -> void {
 				_ASSERT( it != this->end_index() );
-				bitset_type const bitsetRemaining = m_bitset & ~lsb_mask(it - tc::begin(c_rnge) + 1);
-				it = 0 == bitsetRemaining ? this->end_index() : make_index(tc::index_of_least_significant_bit(bitsetRemaining));
+				auto const nIndex = enumset_detail::index_of_first_bit(m_bitset, tc::explicit_cast<int>(it - tc::begin(c_rnge) + 1));
+				it = nIndex < 0 ? this->end_index() : make_index(nIndex);
 			}
 
 			STATIC_FINAL_MOD(constexpr, decrement_index)(tc_index& it) const& noexcept -> void {
 				_ASSERT( it != this->begin_index() );
-				it = make_index(tc::index_of_most_significant_bit(tc::explicit_cast<unsigned long>(m_bitset & lsb_mask(it - tc::begin(c_rnge)))));
+				it = make_index(enumset_detail::index_of_last_bit_below(m_bitset, tc::explicit_cast<int>(it - tc::begin(c_rnge))));
+			}
+
+			// Clears the bits of one word after the other instead of searching for the next bit from the start of the iteration.
+			template<tc::decayed_derived_from<enumset> Self, typename Sink> requires (!std::is_integral<bitset_type>::value)
+			friend constexpr auto for_each_impl(Self&& self, Sink const sink) MAYTHROW -> tc::common_type_t<decltype(tc::continue_if_not_break(sink, std::declval<Enum>())), tc::constant<tc::continue_>> {
+				for( std::size_t nWord = 0; nWord < self.m_bitset.m_an.size(); ++nWord ) {
+					for( auto n = self.m_bitset.m_an[nWord]; 0 != n; n &= n - 1 ) {
+						tc_yield(sink, *make_index(tc::explicit_cast<int>(nWord) * enumset_detail::c_nWordBits + tc::index_of_least_significant_bit(n)));
+					}
+				}
+				return tc::constant<tc::continue_>();
 			}
 		};
 
@@ -261,7 +421,7 @@ namespace tc {
 		constexpr tc::enumset<EnumSuper> explicit_convert_impl(adl_tag_t, tc::type::identity<tc::enumset<EnumSuper>>, tc::enumset<EnumSub> const setesub) noexcept {
 			return tc::enumset<EnumSuper>(
 				tc::enumset_from_underlying_tag,
-				tc::explicit_cast<typename tc::enumset<EnumSuper>::bitset_type>(setesub.m_bitset_()) << tc::all_values<EnumSuper>::index_of(tc::explicit_cast<EnumSuper>(tc::contiguous_enum<EnumSub>::begin()))
+				enumset_detail::shifted<typename tc::enumset<EnumSuper>::bitset_type>(setesub.m_bitset_(), tc::explicit_cast<int>(tc::all_values<EnumSuper>::index_of(tc::explicit_cast<EnumSuper>(tc::contiguous_enum<EnumSub>::begin()))))
 			);
 		}
 
@@ -270,7 +430,7 @@ namespace tc {
 			_ASSERTE(tc::is_subset(setesuper, tc::explicit_cast<tc::enumset<EnumSuper>>(tc::enumset(tc::all_values<EnumSub>()))));
 			return tc::enumset<EnumSub>(
 				tc::enumset_from_underlying_tag,
-				setesuper.m_bitset_() >> tc::all_values<EnumSuper>::index_of(tc::explicit_cast<EnumSuper>(tc::contiguous_enum<EnumSub>::begin()))
+				enumset_detail::shifted<typename tc::enumset<EnumSub>::bitset_type>(setesuper.m_bitset_(), -tc::explicit_cast<int>(tc::all_values<EnumSuper>::index_of(tc::explicit_cast<EnumSuper>(tc::contiguous_enum<EnumSub>::begin()))))
 			);
 		}
 	}
@@ -0,0 +1,291 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/noncopyable.h"
+#include "algorithm/minmax.h"
+#include "algorithm/size.h"
+#include "range/meta.h"
+#include "range/subrange.h"
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+// Keep windows.h from defining min and max macros, which break std::min, std::numeric_limits<T>::max etc. in every includer.
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace tc {
+	struct file_failure final {
+		std::error_code m_ec;
+	};
+
+	namespace file_detail {
+		[[noreturn]] inline void throw_last_error() THROW(tc::file_failure) {
+#ifdef _WIN32
+			throw tc::file_failure{std::error_code(static_cast<int>(::GetLastError()), std::system_category())};
+#else
+			throw tc::file_failure{std::error_code(errno, std::system_category())};
+#endif
+		}
+
+#ifdef _WIN32
+		struct handle_closer final {
+			void operator()(HANDLE const h) const& noexcept {
+				VERIFY(::CloseHandle(h));
+			}
+		};
+		using handle_t = std::unique_ptr<std::remove_pointer_t<HANDLE>, handle_closer>;
+
+		[[nodiscard]] inline handle_t open(std::filesystem::path const& path, DWORD const dwAccess, DWORD const dwCreation) THROW(tc::file_failure) {
+			HANDLE const h = ::CreateFileW(path.c_str(), dwAccess, FILE_SHARE_READ, nullptr, dwCreation, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if( INVALID_HANDLE_VALUE == h ) throw_last_error();
+			return handle_t(h);
+		}
+#else
+		struct fd_closer final {
+			int m_fd;
+			~fd_closer() {
+				if( 0 <= m_fd ) VERIFY(0 == ::close(m_fd));
+			}
+		};
+
+		[[nodiscard]] inline int open(std::filesystem::path const& path, int const nFlags) THROW(tc::file_failure) {
+			int fd;
+			do {
+				fd = ::open(path.c_str(), nFlags | O_CLOEXEC, 0666);
+			} while( fd < 0 && EINTR == errno );
+			if( fd < 0 ) throw_last_error();
+			return fd;
+		}
+#endif
+	}
+
+	namespace no_adl {
+		// Read-only memory mapped file as a contiguous range of T. Trailing bytes which do not form a whole T are not part of
+		// the range. Pages are only read when they are accessed, so iterating over the range streams the file.
+		template<typename T>
+		struct [[nodiscard]] mmap_range final : tc::noncopyable {
+			static_assert( std::is_trivially_copyable<T>::value );
+
+			explicit mmap_range(std::filesystem::path const& path) THROW(tc::file_failure) {
+#ifdef _WIN32
+				auto const hfile = file_detail::open(path, GENERIC_READ, OPEN_EXISTING);
+				LARGE_INTEGER nSize;
+				if( !::GetFileSizeEx(hfile.get(), &nSize) ) file_detail::throw_last_error();
+				if( 0 == nSize.QuadPart ) return; // mapping an empty file fails
+				file_detail::handle_t const hmapping(::CreateFileMappingW(hfile.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+				if( !hmapping ) file_detail::throw_last_error();
+				m_pv = ::MapViewOfFile(hmapping.get(), FILE_MAP_READ, 0, 0, 0);
+				if( !m_pv ) file_detail::throw_last_error();
+				m_nBytes = static_cast<std::size_t>(nSize.QuadPart);
+#else
+				file_detail::fd_closer const fd{file_detail::open(path, O_RDONLY)};
+				struct stat st;
+				if( 0 != ::fstat(fd.m_fd, &st) ) file_detail::throw_last_error();
+				if( 0 == st.st_size ) return; // mapping an empty file fails
+				void* const pv = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd.m_fd, 0);
+				if( MAP_FAILED == pv ) file_detail::throw_last_error();
+				m_pv = pv;
+				m_nBytes = static_cast<std::size_t>(st.st_size);
+#endif
+			}
+
+			mmap_range(mmap_range&& rng) noexcept
+				: m_pv(std::exchange(rng.m_pv, nullptr))
+				, m_nBytes(std::exchange(rng.m_nBytes, 0))
+			{}
+
+			mmap_range& operator=(mmap_range&& rng) & noexcept {
+				std::swap(m_pv, rng.m_pv);
+				std::swap(m_nBytes, rng.m_nBytes);
+				return *this;
+			}
+
+			~mmap_range() {
+				if( m_pv ) {
+#ifdef _WIN32
+					VERIFY(::UnmapViewOfFile(m_pv));
+#else
+					VERIFY(0 == ::munmap(m_pv, m_nBytes));
+#endif
+				}
+			}
+
+			using iterator = T const*;
+			using const_iterator = T const*;
+
+			[[nodiscard]] T const* begin() const& noexcept { return static_cast<T const*>(m_pv); }
+			[[nodiscard]] T const* end() const& noexcept { return begin() + m_nBytes / sizeof(T); }
+
+		private:
+			void* m_pv = nullptr;
+			std::size_t m_nBytes = 0;
+		};
+
+		// Buffered file output. Small writes are collected in a page-aligned buffer, which goes to the file in one call when
+		// it is full. Writes at least as large as the buffer are passed on together with the buffered bytes in one writev.
+		// The destructor writes what is left in the buffer but cannot report failure. Call close() to see errors.
+		struct [[nodiscard]] output_file final : tc::nonmovable {
+			static constexpr std::size_t c_nBuffer = 1 << 20;
+			static constexpr std::size_t c_nAlignment = 4096;
+
+			// Creates the file or truncates an existing one.
+			explicit output_file(std::filesystem::path const& path) THROW(tc::file_failure)
+				: m_pbBuffer(static_cast<unsigned char*>(::operator new(c_nBuffer, std::align_val_t(c_nAlignment))))
+			{
+				try {
+#ifdef _WIN32
+					m_hfile = file_detail::open(path, GENERIC_WRITE, CREATE_ALWAYS);
+#else
+					m_fd = file_detail::open(path, O_WRONLY | O_CREAT | O_TRUNC);
+#endif
+				} catch( ... ) {
+					::operator delete(m_pbBuffer, std::align_val_t(c_nAlignment));
+					throw;
+				}
+			}
+
+			~output_file() {
+				if( is_open() ) {
+					try {
+						close(); // THROW(tc::file_failure)
+					} catch( tc::file_failure const& ) {
+					}
+				}
+				::operator delete(m_pbBuffer, std::align_val_t(c_nAlignment));
+			}
+
+			void write(void const* const pv, std::size_t const n) & THROW(tc::file_failure) {
+				_ASSERT(is_open());
+				auto const pb = static_cast<unsigned char const*>(pv);
+				if( n < c_nBuffer - m_nBuffered ) {
+					std::memcpy(m_pbBuffer + m_nBuffered, pb, n);
+					m_nBuffered += n;
+				} else if( n < c_nBuffer ) {
+					// Fill the buffer to write full blocks only.
+					auto const nFill = c_nBuffer - m_nBuffered;
+					std::memcpy(m_pbBuffer + m_nBuffered, pb, nFill);
+					m_nBuffered = 0;
+					write_all(m_pbBuffer, c_nBuffer, nullptr, 0); // THROW(tc::file_failure)
+					std::memcpy(m_pbBuffer, pb + nFill, n - nFill);
+					m_nBuffered = n - nFill;
+				} else {
+					auto const nBuffered = std::exchange(m_nBuffered, 0);
+					write_all(m_pbBuffer, nBuffered, pb, n); // THROW(tc::file_failure)
+				}
+			}
+
+			void flush() & THROW(tc::file_failure) {
+				_ASSERT(is_open());
+				auto const nBuffered = std::exchange(m_nBuffered, 0);
+				write_all(m_pbBuffer, nBuffered, nullptr, 0); // THROW(tc::file_failure)
+			}
+
+			void close() & THROW(tc::file_failure) {
+				flush(); // THROW(tc::file_failure)
+#ifdef _WIN32
+				m_hfile.reset();
+#else
+				if( 0 != ::close(std::exchange(m_fd, -1)) ) file_detail::throw_last_error();
+#endif
+			}
+
+			[[nodiscard]] bool is_open() const& noexcept {
+#ifdef _WIN32
+				return nullptr != m_hfile;
+#else
+				return 0 <= m_fd;
+#endif
+			}
+
+		private:
+			// Writes [pb0, pb0+n0) followed by [pb1, pb1+n1).
+			void write_all(unsigned char const* pb0, std::size_t n0, unsigned char const* pb1, std::size_t n1) & THROW(tc::file_failure) {
+#ifdef _WIN32
+				for( auto const& pairpbn : {std::make_pair(pb0, n0), std::make_pair(pb1, n1)} ) {
+					for( auto pb = pairpbn.first, pbEnd = pairpbn.first + pairpbn.second; pb != pbEnd; ) {
+						DWORD nWritten;
+						if( !::WriteFile(m_hfile.get(), pb, static_cast<DWORD>(tc::min(pbEnd - pb, static_cast<std::ptrdiff_t>(1) << 30)), &nWritten, nullptr) ) file_detail::throw_last_error();
+						pb += nWritten;
+					}
+				}
+#else
+				while( 0 != n0 || 0 != n1 ) {
+					::iovec aiov[2] = {{const_cast<unsigned char*>(pb0), n0}, {const_cast<unsigned char*>(pb1), n1}};
+					auto const nWritten = ::writev(m_fd, 0 == n0 ? aiov + 1 : aiov, 0 == n0 ? 1 : 2);
+					if( nWritten < 0 ) {
+						if( EINTR == errno ) continue;
+						file_detail::throw_last_error();
+					}
+					auto const nWritten0 = tc::min(static_cast<std::size_t>(nWritten), n0);
+					auto const nWritten1 = static_cast<std::size_t>(nWritten) - nWritten0;
+					pb0 += nWritten0;
+					n0 -= nWritten0;
+					pb1 += nWritten1;
+					n1 -= nWritten1;
+				}
+#endif
+			}
+
+			unsigned char* m_pbBuffer;
+			std::size_t m_nBuffered = 0;
+#ifdef _WIN32
+			file_detail::handle_t m_hfile;
+#else
+			int m_fd = -1;
+#endif
+		};
+
+		// Sink writing the object representation of elements and contiguous chunks to an output_file.
+		struct file_sink final {
+			explicit file_sink(output_file& file) noexcept : m_pfile(std::addressof(file)) {}
+
+			template<typename T> requires std::is_trivially_copyable<T>::value
+			void operator()(T const& t) const& THROW(tc::file_failure) {
+				m_pfile->write(std::addressof(t), sizeof(T)); // THROW(tc::file_failure)
+			}
+
+			template<tc::contiguous_range Rng>
+			void chunk(Rng const& rng) const& THROW(tc::file_failure) {
+				auto const rngb = tc::range_as_blob(rng);
+				m_pfile->write(tc::ptr_begin(rngb), tc::size_raw(rngb)); // THROW(tc::file_failure)
+			}
+
+		private:
+			output_file* m_pfile;
+		};
+
+		// tc::append(file, rng)
+		inline auto appender_impl(output_file& file) noexcept {
+			return file_sink(file);
+		}
+	}
+	using no_adl::mmap_range;
+	using no_adl::output_file;
+	using no_adl::file_sink;
+}
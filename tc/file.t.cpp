@@ -0,0 +1,57 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "algorithm/append.h"
+#include "algorithm/equal.h"
+#include "range/transform.h"
+#include "file.h"
+
+UNITTESTDEF(file_sink_and_mmap_range) {
+	auto const pathIn = std::filesystem::temp_directory_path() / "tc_file_test_in.bin";
+	auto const pathOut = std::filesystem::temp_directory_path() / "tc_file_test_out.bin";
+
+	// Elements, small chunks straddling the buffer end and chunks larger than the buffer.
+	tc::vector<char> vecch;
+	for( std::size_t n = 0; n < 3 * tc::output_file::c_nBuffer + 1234; ++n ) tc::cont_emplace_back(vecch, static_cast<char>('a' + n % 26));
+	{
+		tc::output_file file(pathIn);
+		auto const sink = tc::file_sink(file);
+		for( int n = 0; n < 1000; ++n ) sink(vecch[n]); // elements
+		tc::append(file, tc::make_iterator_range(vecch.data() + 1000, vecch.data() + 5000));
+		tc::append(file, tc::make_iterator_range(vecch.data() + 5000, vecch.data() + tc::output_file::c_nBuffer + 7));
+		tc::append(file, tc::make_iterator_range(vecch.data() + tc::output_file::c_nBuffer + 7, vecch.data() + vecch.size()));
+		file.close();
+	}
+	{
+		tc::mmap_range<char> const rngch(pathIn);
+		_ASSERT(tc::equal(rngch, vecch));
+
+		// stream a transformed copy
+		tc::output_file file(pathOut);
+		tc::for_each(tc::transform(rngch, [](char const ch) noexcept { return static_cast<char>(ch - 'a' + 'A'); }), tc::file_sink(file));
+	} // flushed by the destructor
+	_ASSERT(tc::equal(tc::mmap_range<char>(pathOut), tc::transform(vecch, [](char const ch) noexcept { return static_cast<char>(ch - 'a' + 'A'); })));
+
+	// whole elements only
+	_ASSERTEQUAL(tc::size(tc::mmap_range<std::uint32_t>(pathIn)), tc::size(vecch) / 4);
+
+	{
+		tc::output_file file(pathOut);
+	}
+	_ASSERT(tc::empty(tc::mmap_range<char>(pathOut)));
+
+	std::filesystem::remove(pathIn);
+	std::filesystem::remove(pathOut);
+	try {
+		tc::mmap_range<char> rngch(pathIn);
+		_ASSERTFALSE;
+	} catch( tc::file_failure const& err ) {
+		_ASSERT(std::errc::no_such_file_or_directory == err.m_ec);
+	}
+}
@@ -16,6 +16,8 @@
 #include "algorithm/round.h"
 #include "algorithm/algorithm.h"
 #include "container/container.h" 
+#include "container/flat_map.h"
+#include "algorithm/radix_sort.h"
 #include "range/iota_range.h"
 #include "interval_types.h"
 #include "dense_map.h"
@@ -861,46 +863,6 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				return tLeft < intvlRight[tc::lo];
 			}
 		};	
-
-		// deprecated, had disadvantage that you can only sort by one criterion, not different criterions in different parts of the code
-		template<typename T, typename _Pr>
-		struct vector_as_set : tc::vector< T > {
-			using iterator = tc::iterator_t<tc::vector<T>>;
-			using const_iterator = tc::iterator_t<tc::vector<T> const>;
-			using base_ = tc::vector< T >;
-	
-			iterator lower_bound(T const& t) & noexcept {
-				return tc::lower_bound<tc::return_border>(*this, t, _Pr());
-			}
-
-			const_iterator lower_bound(T const& t) const& noexcept {
-				return tc::lower_bound<tc::return_border>(*this, t, _Pr());
-			}
-
-			iterator upper_bound(T const& t) & noexcept {
-				return tc::upper_bound<tc::return_border>(*this, t, _Pr());
-			}
-
-			const_iterator upper_bound(T const& t) const& noexcept {
-				return tc::upper_bound<tc::return_border>(*this, t, _Pr());
-			}
-
-			template< typename A0 >
-			iterator emplace_hint(iterator& itWhere, A0&& a0) & noexcept {
-				iterator it = base_::emplace(itWhere, std::forward<A0>(a0) );
-				itWhere = it;
-				++itWhere;
-				return it;
-			}
-
-			template< typename A0, typename A1 >
-			iterator emplace_hint(iterator& itWhere, A0&& a0, A1&& a1) & noexcept {
-				iterator it = tc::vector< T >::emplace(itWhere, std::forward<A0>(a0), std::forward<A1>(a1) );
-				itWhere = it;
-				++itWhere;
-				return it;
-			}
-		};
 	}
 
 	namespace interval_set_adl {
@@ -912,10 +874,23 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 			using Cont=std::conditional_t<
 				std::is_same< SetOrVectorImpl, use_set_impl_tag_t >::value,
 				tc::set< TInterval, tc::no_adl::less_begin< T, TInterval > >,
-				tc::no_adl::vector_as_set< TInterval, tc::no_adl::less_begin< T, TInterval > >
+				tc::flat_set< TInterval, tc::no_adl::less_begin< T, TInterval > >
 			>;
 			Cont m_cont;
 
+			// vecintvl must be sorted, disjoint and not adjacent.
+			static Cont make_cont(tc::vector<TInterval> vecintvl) noexcept {
+				if constexpr( std::is_same<SetOrVectorImpl, use_set_impl_tag_t>::value ) {
+					Cont cont;
+					for( auto const& intvl : vecintvl ) {
+						tc::cont_must_emplace_before(cont, tc::end(cont), intvl);
+					}
+					return cont;
+				} else {
+					return Cont(tc::sorted_unique_tag, tc_move(vecintvl));
+				}
+			}
+
 		public:
 			using const_iterator = tc::iterator_t<Cont const>;
 	
@@ -931,6 +906,39 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				: m_cont( itBegin, itEnd )
 			{}
 
+			// Bulk construction in O(n log n) from intervals in any order, which may overlap or be empty: sorting them once and
+			// coalescing overlapping and adjacent ones in a single sweep is much cheaper than inserting them one by one.
+			template<typename Rng>
+			interval_set(tc::range_tag_t, Rng&& rng) noexcept {
+				tc::vector<TInterval> vecintvl;
+				if constexpr( tc::has_size<Rng> ) {
+					tc::cont_reserve(vecintvl, tc::size_raw(rng));
+				}
+				tc::for_each(std::forward<Rng>(rng), [&](auto const& intvl) noexcept {
+					if( !intvl.empty() ) tc::cont_emplace_back(vecintvl, intvl);
+				});
+				if constexpr( tc::radix_key<T> ) {
+					tc::sort_inplace(tc::radix, vecintvl, [](TInterval const& intvl) noexcept { return intvl[tc::lo]; });
+				} else {
+					tc::sort_inplace(vecintvl, tc::no_adl::less_begin<T, TInterval>());
+				}
+
+				auto itintvlOut = tc::begin(vecintvl);
+				for( auto itintvl = itintvlOut; itintvl != tc::end(vecintvl); ++itintvl ) {
+					if( itintvlOut != itintvl ) {
+						if( (*itintvlOut)[tc::hi] < (*itintvl)[tc::lo] ) {
+							*++itintvlOut = *itintvl;
+						} else if( (*itintvlOut)[tc::hi] < (*itintvl)[tc::hi] ) {
+							(*itintvlOut)[tc::hi] = (*itintvl)[tc::hi];
+						}
+					}
+				}
+				if( !tc::empty(vecintvl) ) {
+					tc::take_inplace(vecintvl, tc_modified(itintvlOut, ++_));
+				}
+				m_cont = make_cont(tc_move(vecintvl));
+			}
+
 			const_iterator begin() const& noexcept {
 				return tc::begin(m_cont);
 			}
@@ -1013,10 +1021,30 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				return *this;
 			}
 
+			// Single sweep over both sets in O(n+m).
 			interval_set& operator-=(interval_set const& intvlset) & noexcept {
-				tc::for_each(intvlset.m_cont, [this]( TInterval const& intvl ) noexcept {
-					*this-=intvl;
-				});
+				tc::vector<TInterval> vecintvl;
+				auto itintervalB = tc::begin(intvlset.m_cont);
+				for( TInterval const& intvlA : m_cont ) {
+					T tLo = intvlA[tc::lo];
+					while( itintervalB != tc::end(intvlset.m_cont) && !(tLo < (*itintervalB)[tc::hi]) ) {
+						++itintervalB;
+					}
+					for( ; itintervalB != tc::end(intvlset.m_cont) && (*itintervalB)[tc::lo] < intvlA[tc::hi]; ++itintervalB ) {
+						if( tLo < (*itintervalB)[tc::lo] ) {
+							tc::cont_emplace_back(vecintvl, TInterval(tLo, (*itintervalB)[tc::lo]));
+						}
+						if( !((*itintervalB)[tc::hi] < intvlA[tc::hi]) ) {
+							tLo = intvlA[tc::hi]; // *itintervalB may overlap the next interval as well
+							break;
+						}
+						tLo = (*itintervalB)[tc::hi];
+					}
+					if( tLo < intvlA[tc::hi] ) {
+						tc::cont_emplace_back(vecintvl, TInterval(tLo, intvlA[tc::hi]));
+					}
+				}
+				m_cont = make_cont(tc_move(vecintvl));
 				return *this;
 			}
 
@@ -1048,6 +1076,24 @@ MODIFY_WARNINGS(((suppress)(4552))) // '-': operator has no effect; expected ope
 				);
 			}
 
+			// Whether each of the sorted rngt is contained, as a generator range of bools. A single sweep over the points and
+			// the intervals replaces a lookup per point.
+			template<typename RngT>
+			auto contains_each(RngT&& rngt) const& noexcept {
+				return [this, rngt = tc::make_reference_or_value(tc_move_if_owned(rngt))](auto sink) MAYTHROW {
+					_ASSERTDEBUG( tc::is_sorted(*rngt) );
+					auto itinterval = tc::begin(m_cont);
+					tc_return_if_break(tc::for_each(*rngt, [&](auto const& t) MAYTHROW {
+						while( itinterval != tc::end(m_cont) && !(t < (*itinterval)[tc::hi]) ) {
+							++itinterval;
+						}
+						tc_yield(sink, itinterval != tc::end(m_cont) && !(t < (*itinterval)[tc::lo]));
+						return tc::continue_;
+					}));
+					return tc::continue_;
+				};
+			}
+
 			void erase_to(T const& t) & noexcept {
 				auto itinterval = m_cont.lower_bound(t);
 				if( itinterval!=tc::begin(m_cont) ) {
@@ -208,3 +208,69 @@ UNITTESTDEF(linear_interval_transform) {
 	Test(-1.0, 1.0, -1.0, -2.0, std::make_pair(-0.5, -1.25), std::make_pair(0.0, -1.5), std::make_pair(0.5, -1.75), std::make_pair(2.0, -2.5), std::make_pair(3.0, -3));
 	Test(1e-20, 1e20, 1e30, -1e-20);
 }
+
+UNITTESTDEF(interval_set_vector_impl) {
+	tc::interval_set<int, tc::interval<int>, tc::use_vector_impl_tag_t> intvlset;
+	intvlset |= tc::make_interval(0, 10);
+	intvlset |= tc::make_interval(20, 30);
+	intvlset |= tc::make_interval(5, 25);
+	intvlset |= tc::make_interval(40, 50);
+	_ASSERTEQUAL(tc::size(intvlset), 2);
+	intvlset -= tc::make_interval(10, 20);
+	_ASSERTEQUAL(tc::size(intvlset), 3);
+	_ASSERT(intvlset.intersects(tc::make_interval(45, 46)));
+	_ASSERT(!intvlset.intersects(tc::make_interval(12, 18)));
+}
+
+namespace {
+	template<typename SetOrVectorImpl>
+	void test_interval_set_bulk() noexcept {
+		using intvlset_t = tc::interval_set<int, tc::interval<int>, SetOrVectorImpl>;
+
+		unsigned int nState = 4711;
+		auto const Random = [&](int const nMax) noexcept {
+			nState = nState * 1103515245u + 12345u;
+			return static_cast<int>((nState >> 8) % nMax);
+		};
+		tc::vector<tc::interval<int>> vecintvl;
+		for( int n = 0; n < 500; ++n ) {
+			int const nLo = Random(2000);
+			tc::cont_emplace_back(vecintvl, nLo, nLo + Random(10)); // some are empty, some adjacent
+		}
+
+		intvlset_t intvlsetExpected;
+		for( auto const& intvl : vecintvl ) intvlsetExpected |= intvl;
+		intvlset_t const intvlset(tc::range_tag, vecintvl);
+		_ASSERTEQUAL(intvlset, intvlsetExpected);
+		_ASSERT(intvlset_t(tc::range_tag, tc::vector<tc::interval<int>>{tc::make_interval(3, 3)}).empty());
+		_ASSERTEQUAL(intvlset_t(tc::range_tag, tc::vector<tc::interval<int>>{tc::make_interval(5, 7), tc::make_interval(0, 5)}), intvlset_t(tc::make_interval(0, 7)));
+
+		// merge-based -= against one interval at a time
+		intvlset_t const intvlsetSub(tc::range_tag, tc::transform(tc::begin_next<tc::return_take>(vecintvl, 100), [](tc::interval<int> const& intvl) noexcept {
+			return tc::make_interval(intvl[tc::lo] + 3, intvl[tc::hi] + 20);
+		}));
+		auto intvlsetDiff = intvlset;
+		intvlsetDiff -= intvlsetSub;
+		auto intvlsetDiffExpected = intvlset;
+		tc::for_each(intvlsetSub, [&](tc::interval<int> const& intvl) noexcept { intvlsetDiffExpected -= intvl; });
+		_ASSERTEQUAL(intvlsetDiff, intvlsetDiffExpected);
+		_ASSERT(!intvlsetDiff.intersects(intvlsetSub));
+
+		auto intvlsetEmpty = intvlset;
+		intvlsetEmpty -= intvlset;
+		_ASSERT(intvlsetEmpty.empty());
+		intvlsetEmpty -= intvlset;
+		_ASSERT(intvlsetEmpty.empty());
+
+		// batched point queries
+		auto const vecnPoint = tc::make_vector(tc::iota(-5, 2020));
+		tc::vector<bool> vecbContains;
+		tc::for_each(intvlset.contains_each(vecnPoint), [&](bool const b) noexcept { tc::cont_emplace_back(vecbContains, b); });
+		_ASSERT(tc::equal(vecbContains, tc::transform(vecnPoint, [&](int const n) noexcept { return intvlset.contains(n); })));
+	}
+}
+
+UNITTESTDEF(interval_set_bulk) {
+	test_interval_set_bulk<tc::use_set_impl_tag_t>();
+	test_interval_set_bulk<tc::use_vector_impl_tag_t>();
+}
@@ -0,0 +1,242 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "algorithm/partition_range.h"
+#include "algorithm/radix_sort.h"
+#include "interval.h"
+
+#include <array>
+#include <utility>
+
+namespace tc {
+	namespace interval_map_adl {
+		// Values attached to possibly overlapping intervals, e.g., annotations of text ranges, with queries for the values whose
+		// interval contains a point or overlaps an interval.
+		// The elements are stored in a vector sorted by lower bound, which doubles as an implicit balanced binary tree: the nodes
+		// of level k are the indices whose k lowest bits are set and whose bit k is not, leaves are the even indices. Every node
+		// knows the maximal upper bound in its subtree, so queries skip the subtrees ending too early and visit O(log n + m) nodes
+		// for m results, with the memory access pattern of a binary search.
+		// Inserting or erasing a single element is O(n), like for tc::flat_set, so build the map from a whole range when possible.
+		template<typename T, typename Value>
+		struct interval_map final {
+			using value_type = std::pair<tc::interval<T>, Value>;
+		private:
+			using Cont = tc::vector<value_type>;
+			Cont m_cont;
+			tc::vector<T> m_vectMaxHi; // maximal upper bound in the subtree of each node
+			int m_nLevelRoot = -1;
+
+			static T const& lo(value_type const& pairintvlval) noexcept {
+				return pairintvlval.first[tc::lo];
+			}
+			static T const& hi(value_type const& pairintvlval) noexcept {
+				return pairintvlval.first[tc::hi];
+			}
+
+			// Like in cgranges, the maximal upper bounds of the nodes are computed bottom-up level by level. The last node of every
+			// level may lack its right subtree or have a right child index beyond the end, whose elements are then those of the
+			// last existing subtree, tracked in tLast.
+			void index() & noexcept {
+				auto const n = tc::size_raw(m_cont);
+				tc::cont_assign(m_vectMaxHi, tc::transform(m_cont, fn_hi()));
+				if( 0 == n ) {
+					m_nLevelRoot = -1;
+					return;
+				}
+				std::size_t nLast = (n - 1) & ~std::size_t(1);
+				T tLast = m_vectMaxHi[nLast];
+				int nLevel = 1;
+				for( ; (std::size_t(1) << nLevel) <= n; ++nLevel ) {
+					std::size_t const nHalf = std::size_t(1) << (nLevel - 1);
+					for( std::size_t i = (nHalf << 1) - 1; i < n; i += nHalf << 2 ) {
+						auto& tMaxHi = m_vectMaxHi[i];
+						tc::assign_max(tMaxHi, m_vectMaxHi[i - nHalf], i + nHalf < n ? m_vectMaxHi[i + nHalf] : tLast);
+					}
+					nLast = (nLast >> nLevel & 1) ? nLast - nHalf : nLast + nHalf;
+					if( nLast < n ) tc::assign_max(tLast, m_vectMaxHi[nLast]);
+				}
+				m_nLevelRoot = nLevel - 1;
+			}
+
+			struct fn_hi final {
+				T const& operator()(value_type const& pairintvlval) const& noexcept {
+					return hi(pairintvlval);
+				}
+			};
+
+			template<typename Sink>
+			using for_each_result_t = tc::common_type_t<
+				decltype(tc::continue_if_not_break(std::declval<Sink const&>(), std::declval<value_type const&>())),
+				tc::constant<tc::continue_>
+			>;
+
+			// Calls sink for the elements whose lower bound satisfies predlo and whose upper bound satisfies predhi, ordered by lower
+			// bound. predlo must hold for a prefix of the elements, and predhi(t) must imply predhi(t') for all t < t'.
+			template<typename PredLo, typename PredHi, typename Sink>
+			auto for_each_matching(PredLo const& predlo, PredHi const& predhi, Sink const& sink) const& MAYTHROW -> for_each_result_t<Sink> {
+				if( m_nLevelRoot < 0 ) return tc::constant<tc::continue_>();
+				auto const n = tc::size_raw(m_cont);
+				struct node final {
+					std::size_t m_i;
+					int m_nLevel;
+					bool m_bLeftDone;
+				};
+				std::array<node, 2 * std::numeric_limits<std::size_t>::digits> anode; // each level pushes at most one node
+				std::size_t nNodes = 0;
+				anode[nNodes++] = {(std::size_t(1) << m_nLevelRoot) - 1, m_nLevelRoot, false};
+				while( 0 < nNodes ) {
+					auto const nodeTop = anode[--nNodes];
+					if( nodeTop.m_nLevel <= 3 ) {
+						// Small subtrees are scanned linearly.
+						std::size_t const iBegin = nodeTop.m_i >> nodeTop.m_nLevel << nodeTop.m_nLevel;
+						std::size_t const iEnd = tc::min(n, iBegin + (std::size_t(1) << (nodeTop.m_nLevel + 1)) - 1);
+						for( std::size_t i = iBegin; i < iEnd && predlo(lo(m_cont[i])); ++i ) {
+							if( predhi(hi(m_cont[i])) ) tc_yield(sink, m_cont[i]);
+						}
+					} else if( !nodeTop.m_bLeftDone ) {
+						std::size_t const iLeft = nodeTop.m_i - (std::size_t(1) << (nodeTop.m_nLevel - 1));
+						anode[nNodes++] = {nodeTop.m_i, nodeTop.m_nLevel, true};
+						// Beyond the end, the maximal upper bound is unknown, so the subtree must be searched.
+						if( n <= iLeft || predhi(m_vectMaxHi[iLeft]) ) {
+							anode[nNodes++] = {iLeft, nodeTop.m_nLevel - 1, false};
+						}
+					} else if( nodeTop.m_i < n && predlo(lo(m_cont[nodeTop.m_i])) ) {
+						if( predhi(hi(m_cont[nodeTop.m_i])) ) tc_yield(sink, m_cont[nodeTop.m_i]);
+						anode[nNodes++] = {nodeTop.m_i + (std::size_t(1) << (nodeTop.m_nLevel - 1)), nodeTop.m_nLevel - 1, false};
+					}
+				}
+				return tc::constant<tc::continue_>();
+			}
+
+		public:
+			using const_iterator = tc::iterator_t<Cont const>;
+			using iterator = const_iterator; // elements only change by insert and erase, which keep the tree up to date
+
+			interval_map() noexcept
+			{}
+
+			// Bulk construction from pairs of interval and value in any order. Elements with equal lower bounds keep their order.
+			template<typename Rng>
+			interval_map(tc::range_tag_t, Rng&& rng) noexcept {
+				if constexpr( tc::has_size<Rng> ) {
+					tc::cont_reserve(m_cont, tc::size_raw(rng));
+				}
+				tc::for_each(std::forward<Rng>(rng), [&](auto&& pairintvlval) noexcept {
+					tc::cont_emplace_back(m_cont, tc_move_if_owned(pairintvlval));
+				});
+				if constexpr( tc::radix_key<T> ) {
+					// The elements are not trivially copyable, so radix sort the lower bounds with the element indices, then permute.
+					struct lo_index final {
+						T m_tLo;
+						std::size_t m_n;
+					};
+					tc::vector<lo_index> veclon;
+					tc::cont_reserve(veclon, tc::size_raw(m_cont));
+					for( std::size_t n = 0; n < tc::size_raw(m_cont); ++n ) {
+						tc::cont_emplace_back(veclon, lo_index{lo(m_cont[n]), n});
+					}
+					tc::sort_inplace(tc::radix, veclon, [](lo_index const& lon) noexcept { return lon.m_tLo; });
+					Cont contSorted;
+					tc::cont_reserve(contSorted, tc::size_raw(m_cont));
+					for( auto const& lon : veclon ) {
+						tc::cont_emplace_back(contSorted, tc_move_always(m_cont[lon.m_n]));
+					}
+					m_cont = tc_move(contSorted);
+				} else {
+					tc::stable_sort_inplace(m_cont, tc::projected(tc::fn_less(), [](value_type const& pairintvlval) noexcept -> T const& { return lo(pairintvlval); }));
+				}
+				index();
+			}
+
+			const_iterator begin() const& noexcept {
+				return tc::begin(m_cont);
+			}
+
+			const_iterator end() const& noexcept {
+				return tc::end(m_cont);
+			}
+
+			std::size_t size() const& noexcept {
+				return tc::size_raw(m_cont);
+			}
+
+			bool empty() const& noexcept {
+				return tc::empty(m_cont);
+			}
+
+			void clear() & noexcept {
+				m_cont.clear();
+				m_vectMaxHi.clear();
+				m_nLevelRoot = -1;
+			}
+
+			// Inserts behind the elements with the same lower bound. O(n).
+			const_iterator insert(tc::interval<T> const& intvl, Value val) & noexcept {
+				auto const itBefore = tc::upper_bound<tc::return_border>(m_cont, intvl[tc::lo], [](T const& t, value_type const& pairintvlval) noexcept {
+					return t < lo(pairintvlval);
+				});
+				auto const i = itBefore - tc::begin(m_cont);
+				NOBADALLOC(m_cont.emplace(itBefore, intvl, tc_move(val)));
+				index();
+				return tc::begin(m_cont) + i;
+			}
+
+			// O(n)
+			const_iterator erase(const_iterator const it) & noexcept {
+				auto const i = it - tc::begin(m_cont);
+				m_cont.erase(it);
+				index();
+				return tc::begin(m_cont) + i;
+			}
+
+			// Erases the first element equal to (intvl, val), returns whether there was one. O(n).
+			bool erase(tc::interval<T> const& intvl, Value const& val) & noexcept {
+				for(
+					auto it = tc::lower_bound<tc::return_border>(m_cont, intvl[tc::lo], [](value_type const& pairintvlval, T const& t) noexcept {
+						return lo(pairintvlval) < t;
+					});
+					it != tc::end(m_cont) && !(intvl[tc::lo] < lo(*it));
+					++it
+				) {
+					if( intvl == it->first && val == it->second ) {
+						erase(it);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// The elements whose interval overlaps intvl, i.e., begins before the end of intvl and ends after its begin, ordered by
+			// lower bound, as a generator range. Nothing overlaps an empty intvl, but empty elements strictly inside intvl do overlap it.
+			auto overlapping(tc::interval<T> const& intvl) const& noexcept {
+				return [this, intvl](auto sink) MAYTHROW -> for_each_result_t<decltype(sink)> {
+					if( intvl.empty() ) return tc::constant<tc::continue_>();
+					return for_each_matching(
+						[&](T const& tLo) noexcept { return tLo < intvl[tc::hi]; },
+						[&](T const& tHi) noexcept { return intvl[tc::lo] < tHi; },
+						sink
+					);
+				};
+			}
+
+			// The elements whose interval contains t, ordered by lower bound, as a generator range.
+			auto containing(T const& t) const& noexcept {
+				return [this, t](auto sink) MAYTHROW {
+					return for_each_matching(
+						[&](T const& tLo) noexcept { return !(t < tLo); },
+						[&](T const& tHi) noexcept { return t < tHi; },
+						sink
+					);
+				};
+			}
+		};
+	}
+	using interval_map_adl::interval_map;
+}
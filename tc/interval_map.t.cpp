@@ -0,0 +1,103 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "algorithm/equal.h"
+#include "range/filter_adaptor.h"
+#include "interval_map.h"
+
+namespace {
+	using intvlmap_t = tc::interval_map<int, int>;
+
+	tc::vector<intvlmap_t::value_type> random_intervals(std::size_t const nSize, int const nMax, int const nMaxLength) noexcept {
+		unsigned int nState = 4711;
+		auto const Random = [&](int const n) noexcept {
+			nState = nState * 1103515245u + 12345u;
+			return static_cast<int>((nState >> 8) % n);
+		};
+		tc::vector<intvlmap_t::value_type> vecpairintvln;
+		for( std::size_t n = 0; n < nSize; ++n ) {
+			int const nLo = Random(nMax);
+			tc::cont_emplace_back(vecpairintvln, tc::make_interval(nLo, nLo + Random(nMaxLength)), tc::explicit_cast<int>(n));
+		}
+		return vecpairintvln;
+	}
+
+	// The linear scan which interval_map replaces, in the order of interval_map: by lower bound, then by insertion.
+	void check_queries(intvlmap_t const& intvlmap, tc::vector<intvlmap_t::value_type> vecpairintvln, int const nMax) noexcept {
+		tc::stable_sort_inplace(vecpairintvln, [](auto const& lhs, auto const& rhs) noexcept { return lhs.first[tc::lo] < rhs.first[tc::lo]; });
+		_ASSERT(tc::equal(intvlmap, vecpairintvln));
+		for( int n = -1; n <= nMax + 1; ++n ) {
+			_ASSERT(tc::equal(
+				intvlmap.containing(n),
+				tc::filter(vecpairintvln, [&](auto const& pairintvln) noexcept { return pairintvln.first.contains(n); })
+			));
+			for( int const nLength : {0, 1, 7} ) {
+				auto const intvl = tc::make_interval(n, n + nLength);
+				_ASSERT(tc::equal(
+					intvlmap.overlapping(intvl),
+					tc::filter(vecpairintvln, [&](auto const& pairintvln) noexcept {
+						return !intvl.empty() && pairintvln.first[tc::lo] < intvl[tc::hi] && intvl[tc::lo] < pairintvln.first[tc::hi];
+					})
+				));
+			}
+		}
+	}
+}
+
+UNITTESTDEF(interval_map_queries) {
+	for( std::size_t const nSize : {0, 1, 2, 3, 15, 16, 17, 100, 300, 1000} ) { // incomplete trees, radix sorted from 256 elements
+		for( int const nMaxLength : {1, 10, 100} ) {
+			auto const vecpairintvln = random_intervals(nSize, 200, nMaxLength);
+			check_queries(intvlmap_t(tc::range_tag, vecpairintvln), vecpairintvln, 200);
+		}
+	}
+
+	intvlmap_t const intvlmap(tc::range_tag, tc::vector<intvlmap_t::value_type>{
+		{tc::make_interval(0, 10), 0}, {tc::make_interval(5, 6), 1}, {tc::make_interval(2, 3), 2}, {tc::make_interval(5, 5), 3}
+	});
+	_ASSERT(tc::equal(tc::transform(intvlmap.containing(5), tc_member(.second)), tc::vector<int>{0, 1}));
+	_ASSERT(tc::equal(tc::transform(intvlmap.overlapping(tc::make_interval(3, 5)), tc_member(.second)), tc::vector<int>{0}));
+	_ASSERT(tc::empty(intvlmap.containing(10)));
+	_ASSERT(tc::empty(intvlmap.overlapping(tc::make_interval(3, 3))));
+	_ASSERT(tc::equal(tc::transform(intvlmap.overlapping(tc::make_interval(4, 6)), tc_member(.second)), tc::vector<int>{0, 1, 3}));
+
+	// breaking from the generator
+	int nCalls = 0;
+	_ASSERTEQUAL(tc::for_each(intvlmap.overlapping(tc::make_interval(0, 10)), [&](auto const&) noexcept { ++nCalls; return tc::break_; }), tc::break_);
+	_ASSERTEQUAL(nCalls, 1);
+}
+
+UNITTESTDEF(interval_map_insert_erase) {
+	auto vecpairintvln = random_intervals(300, 100, 20);
+	intvlmap_t intvlmap;
+	_ASSERT(tc::empty(intvlmap.containing(0)));
+	for( auto const& pairintvln : vecpairintvln ) {
+		intvlmap.insert(pairintvln.first, pairintvln.second);
+	}
+	check_queries(intvlmap, vecpairintvln, 100);
+
+	for( std::size_t n = 0; n < 200; n += 2 ) {
+		_ASSERT(intvlmap.erase(vecpairintvln[n].first, vecpairintvln[n].second));
+		_ASSERT(!intvlmap.erase(vecpairintvln[n].first, vecpairintvln[n].second));
+	}
+	tc::vector<intvlmap_t::value_type> vecpairintvlnRemaining;
+	for( std::size_t n = 0; n < tc::size(vecpairintvln); ++n ) {
+		if( 200 <= n || 1 == n % 2 ) tc::cont_emplace_back(vecpairintvlnRemaining, vecpairintvln[n]);
+	}
+	check_queries(intvlmap, vecpairintvlnRemaining, 100);
+
+	while( !tc::empty(intvlmap) ) {
+		intvlmap.erase(tc::begin(intvlmap));
+	}
+	_ASSERT(tc::empty(intvlmap.overlapping(tc::make_interval(0, 200))));
+	intvlmap.insert(tc::make_interval(1, 2), 7);
+	_ASSERT(tc::equal(tc::transform(intvlmap.containing(1), tc_member(.second)), tc::vector<int>{7}));
+	intvlmap.clear();
+	_ASSERTEQUAL(intvlmap.size(), 0);
+}
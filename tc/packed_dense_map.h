@@ -0,0 +1,222 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/integer.h"
+#include "dense_map.h"
+#include "range/range_adaptor.h"
+
+#include <boost/container_hash/hash.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+
+namespace tc {
+	namespace packed_dense_map_detail {
+		// Each value is stored as its index in tc::all_values<Value>, in as few bits as the number of values permits.
+		template<typename Value>
+		inline constexpr int c_nBitsPerValue = tc::max(1, tc::explicit_cast<int>(std::bit_width(tc::explicit_cast<std::size_t>(tc::constexpr_size<tc::all_values<Value>>::value) - 1)));
+
+		// Maps which fit into 64 bits are a single integer of the smallest sufficient size. Larger maps are arrays of 64 bit
+		// words. Values never straddle two words.
+		template<std::size_t nKeys, int nBitsPerValue, bool bSingleWord = nKeys * nBitsPerValue <= std::numeric_limits<std::uint64_t>::digits>
+		struct word final {
+			using type = typename tc::integer<tc::explicit_cast<int>(nKeys * nBitsPerValue)>::unsigned_;
+		};
+
+		template<std::size_t nKeys, int nBitsPerValue>
+		struct word<nKeys, nBitsPerValue, false> final {
+			using type = std::uint64_t;
+		};
+	}
+
+	namespace packed_dense_map_adl {
+		// Like tc::dense_map<Key, Value>, but for Values with few possible values, e.g., bool or small enums, which are packed
+		// into ceil(log2(|Value|)) bits each. Elements are returned by value and written through proxy references, so unlike
+		// tc::dense_map, there are no references to elements. Default-constructed elements are the first of tc::all_values<Value>.
+		template<typename Key, typename Value>
+		struct packed_dense_map final
+			: tc::range_iterator_from_index<packed_dense_map<Key, Value>, std::size_t>
+		{
+			static constexpr tc::all_values<Key> c_rngkey{};
+		private:
+			using this_type = packed_dense_map;
+			static constexpr tc::all_values<Value> c_rngvalue{};
+
+			static_assert( !std::is_reference<Value>::value && !std::is_const<Value>::value && !std::is_volatile<Value>::value );
+
+			static constexpr std::size_t c_nKeys = tc::size(c_rngkey);
+			static constexpr int c_nBitsPerValue = packed_dense_map_detail::c_nBitsPerValue<Value>;
+			using word_t = typename packed_dense_map_detail::word<c_nKeys, c_nBitsPerValue>::type;
+			static constexpr std::size_t c_nValuesPerWord = std::numeric_limits<word_t>::digits / c_nBitsPerValue;
+			static constexpr std::size_t c_nWords = (c_nKeys + c_nValuesPerWord - 1) / c_nValuesPerWord;
+			static constexpr word_t c_wordValueMask = static_cast<word_t>(static_cast<word_t>(-1) >> (std::numeric_limits<word_t>::digits - c_nBitsPerValue));
+
+			std::array<word_t, c_nWords> m_an{}; // bits beyond the last value are always 0, so maps can be compared and hashed word by word
+
+			static constexpr word_t encode(Value const& val) noexcept {
+				return tc::explicit_cast<word_t>(c_rngvalue.index_of(val));
+			}
+			static constexpr Value decode(word_t const n) noexcept {
+				return static_cast<Value>(tc_at_nodebug(c_rngvalue, n));
+			}
+
+			constexpr Value get(std::size_t const nKey) const& noexcept {
+				_ASSERTDEBUG( nKey < c_nKeys );
+				return decode(static_cast<word_t>((m_an[nKey / c_nValuesPerWord] >> (nKey % c_nValuesPerWord * c_nBitsPerValue)) & c_wordValueMask));
+			}
+			constexpr void set(std::size_t const nKey, Value const& val) & noexcept {
+				_ASSERTDEBUG( nKey < c_nKeys );
+				auto& n = m_an[nKey / c_nValuesPerWord];
+				auto const nShift = nKey % c_nValuesPerWord * c_nBitsPerValue;
+				n = static_cast<word_t>((n & ~(c_wordValueMask << nShift)) | (encode(val) << nShift));
+			}
+
+			// Builds every word in a register before storing it.
+			template<typename Func>
+			constexpr void assign_words(Func func) & MAYTHROW {
+				for( std::size_t nWord = 0; nWord < c_nWords; ++nWord ) {
+					word_t n = 0;
+					auto const nKeyEnd = tc::min(c_nKeys, (nWord + 1) * c_nValuesPerWord);
+					for( std::size_t nKey = nWord * c_nValuesPerWord; nKey < nKeyEnd; ++nKey ) {
+						n = static_cast<word_t>(n | (encode(func(nKey)) << (nKey % c_nValuesPerWord * c_nBitsPerValue))); // MAYTHROW
+					}
+					m_an[nWord] = n;
+				}
+			}
+
+		public:
+			using typename this_type::range_iterator_from_index::tc_index;
+			static constexpr bool c_bHasStashingIndex = false;
+			using dense_map_key_type = Key;
+
+			struct reference final {
+				constexpr operator Value() const& noexcept {
+					return m_pdm->get(m_nKey);
+				}
+				constexpr reference const& operator=(Value const& val) const& noexcept {
+					m_pdm->set(m_nKey, val);
+					return *this;
+				}
+				constexpr reference const& operator=(reference const& ref) const& noexcept {
+					return *this = static_cast<Value>(ref);
+				}
+
+			private:
+				friend packed_dense_map;
+				constexpr reference(packed_dense_map& dm, std::size_t const nKey) noexcept : m_pdm(std::addressof(dm)), m_nKey(nKey) {}
+
+				packed_dense_map* m_pdm;
+				std::size_t m_nKey;
+			};
+
+			constexpr packed_dense_map() noexcept = default;
+
+			template<typename Arg>
+			constexpr packed_dense_map(tc::fill_tag_t, Arg&& arg) noexcept {
+				Value const val(std::forward<Arg>(arg));
+				assign_words([&](std::size_t) noexcept { return val; });
+			}
+
+			template<typename Func> requires tc::is_invocable<Func&, Key>::value
+			constexpr packed_dense_map(tc::func_tag_t, Func func) MAYTHROW {
+				assign_words([&](std::size_t const nKey) MAYTHROW -> Value {
+					return tc::invoke(func, static_cast<Key>(tc_at_nodebug(c_rngkey, nKey)));
+				});
+			}
+
+			template<typename Rng>
+			constexpr packed_dense_map(tc::range_tag_t, Rng&& rng) noexcept {
+				_ASSERTEQUAL( tc::size(rng), c_nKeys );
+				auto it = tc::begin(rng);
+				assign_words([&](std::size_t) noexcept -> Value { return *it++; });
+			}
+
+			// aggregate construction, as tc::dense_map
+			template<typename First, typename Second, typename... Args>
+				requires (!tc::tag<std::remove_reference_t<First>>) && (c_nKeys == 2 + sizeof...(Args))
+					&& std::is_convertible<First&&, Value>::value && std::is_convertible<Second&&, Value>::value && (std::is_convertible<Args&&, Value>::value && ...)
+			constexpr packed_dense_map(First&& first, Second&& second, Args&&... args) noexcept {
+				std::array<Value, c_nKeys> const aval{std::forward<First>(first), std::forward<Second>(second), std::forward<Args>(args)...};
+				assign_words([&](std::size_t const nKey) noexcept { return aval[nKey]; });
+			}
+
+			// bulk transform from and to the unpacked form
+			constexpr packed_dense_map(tc::dense_map<Key, Value> const& dm) noexcept {
+				assign_words([&](std::size_t const nKey) noexcept -> Value const& { return tc_at_nodebug(dm, nKey); });
+			}
+
+			constexpr explicit operator tc::dense_map<Key, Value>() const& noexcept {
+				return tc::dense_map<Key, Value>(tc::range_tag, *this);
+			}
+
+			// access
+			[[nodiscard]] constexpr Value operator[](Key const key) const& noexcept {
+				return get(c_rngkey.index_of(key));
+			}
+			[[nodiscard]] constexpr reference operator[](Key const key) & noexcept {
+				return reference(*this, c_rngkey.index_of(key));
+			}
+
+			[[nodiscard]] friend constexpr bool operator==(packed_dense_map const& lhs, packed_dense_map const& rhs) noexcept {
+				return EQUAL_MEMBERS(m_an);
+			}
+
+			[[nodiscard]] std::size_t hash() const& noexcept {
+				return boost::hash_range(tc::begin(m_an), tc::end(m_an));
+			}
+
+			// iteration over the values in the order of the keys
+			STATIC_FINAL_MOD(constexpr, begin_index)() const& noexcept -> tc_index {
+				return 0;
+			}
+
+			STATIC_FINAL_MOD(constexpr, end_index)() const& noexcept -> tc_index {
+				return c_nKeys;
+			}
+
+			STATIC_FINAL_MOD(constexpr, dereference_index)(tc_index const nKey) const& noexcept -> Value {
+				return get(nKey);
+			}
+
+			STATIC_FINAL_MOD(constexpr, increment_index)(tc_index& nKey) const& noexcept -> void {
+				_ASSERTDEBUG( nKey != c_nKeys );
+				++nKey;
+			}
+
+			STATIC_FINAL_MOD(constexpr, decrement_index)(tc_index& nKey) const& noexcept -> void {
+				_ASSERTDEBUG( 0 != nKey );
+				--nKey;
+			}
+
+#ifdef TC_PRIVATE
+		private:
+			template<typename HashAlgorithm>
+			friend void hash_append_impl(HashAlgorithm& h, packed_dense_map const& dm) noexcept {
+				tc::hash_append(h, dm.m_an);
+			}
+#endif
+		};
+	}
+	using packed_dense_map_adl::packed_dense_map;
+
+	namespace no_adl {
+		template<typename Key, typename Value>
+		struct constexpr_size_impl<tc::packed_dense_map<Key, Value>> : tc::constexpr_size<tc::all_values<Key>> {};
+	}
+}
+
+template<typename Key, typename Value>
+struct std::hash<tc::packed_dense_map<Key, Value>> {
+	std::size_t operator()(tc::packed_dense_map<Key, Value> const& dm) const& noexcept {
+		return dm.hash();
+	}
+};
@@ -0,0 +1,77 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "algorithm/equal.h"
+#include "packed_dense_map.h"
+
+#define CONSTANTS4(pre) (pre ## 0)(pre ## 1)(pre ## 2)(pre ## 3)
+#define CONSTANTS16(pre) CONSTANTS4(pre ## 0)CONSTANTS4(pre ## 1)CONSTANTS4(pre ## 2)CONSTANTS4(pre ## 3)
+#define CONSTANTS64(pre) CONSTANTS16(pre ## 0)CONSTANTS16(pre ## 1)CONSTANTS16(pre ## 2)CONSTANTS16(pre ## 3)
+
+namespace {
+	TC_DEFINE_ENUM(EFlag, eflag, (A)(B)(C)(D)(E))
+	TC_DEFINE_ENUM(EState, estate, (OFF)(ON)(UNKNOWN))
+	TC_DEFINE_ENUM(EFeature, efeature, CONSTANTS64(a)CONSTANTS16(b0)CONSTANTS16(b1))
+}
+
+STATICASSERTEQUAL( sizeof(tc::packed_dense_map<EFlag, bool>), 1 );
+STATICASSERTEQUAL( sizeof(tc::packed_dense_map<EFlag, EState>), 2 );
+STATICASSERTEQUAL( sizeof(tc::packed_dense_map<EFeature, bool>), 2 * sizeof(std::uint64_t) );
+STATICASSERTEQUAL( sizeof(tc::packed_dense_map<EFeature, EState>), 3 * sizeof(std::uint64_t) );
+STATICASSERTEQUAL( sizeof(tc::packed_dense_map<EFeature, EFlag>), 5 * sizeof(std::uint64_t) ); // 21 values of 3 bits per word
+
+UNITTESTDEF(packed_dense_map_bool) {
+	tc::packed_dense_map<EFlag, bool> dmb;
+	_ASSERT(tc::equal(dmb, tc::dense_map<EFlag, bool>(tc::fill_tag, false)));
+	dmb[eflagB] = true;
+	dmb[eflagE] = dmb[eflagB];
+	_ASSERT(dmb[eflagB]);
+	_ASSERT(!dmb[eflagC]);
+	_ASSERTEQUAL(dmb, (tc::packed_dense_map<EFlag, bool>(false, true, false, false, true)));
+	_ASSERTEQUAL((tc::explicit_cast<tc::dense_map<EFlag, bool>>(dmb)), (tc::dense_map<EFlag, bool>(false, true, false, false, true)));
+
+	dmb[eflagB] = false;
+	_ASSERTEQUAL(dmb, (tc::packed_dense_map<EFlag, bool>(tc::func_tag, [](EFlag const eflag) noexcept { return eflagE == eflag; })));
+}
+
+UNITTESTDEF(packed_dense_map_multi_word) {
+	auto const dm = tc::dense_map<EFeature, EFlag>(tc::func_tag, [](EFeature const efeature) noexcept {
+		return static_cast<EFlag>((efeature - efeaturea000) % 5);
+	});
+	tc::packed_dense_map<EFeature, EFlag> dmPacked = dm;
+	_ASSERT(tc::equal(dmPacked, dm));
+	_ASSERTEQUAL((tc::explicit_cast<tc::dense_map<EFeature, EFlag>>(dmPacked)), dm);
+	_ASSERTEQUAL(tc::size(dmPacked), 96);
+
+	// last value of the first word and first value of the second word
+	_ASSERTEQUAL(dmPacked[efeaturea110], eflagA);
+	_ASSERTEQUAL(dmPacked[efeaturea111], eflagB);
+	dmPacked[efeaturea110] = eflagE;
+	dmPacked[efeaturea111] = eflagD;
+	_ASSERTEQUAL(dmPacked[efeaturea103], eflagE);
+	_ASSERTEQUAL(dmPacked[efeaturea110], eflagE);
+	_ASSERTEQUAL(dmPacked[efeaturea111], eflagD);
+	_ASSERTEQUAL(dmPacked[efeaturea112], eflagC);
+
+	auto dmPacked2 = dmPacked;
+	_ASSERTEQUAL(dmPacked2, dmPacked);
+	using hash_t = std::hash<tc::packed_dense_map<EFeature, EFlag>>;
+	_ASSERTEQUAL(hash_t()(dmPacked2), hash_t()(dmPacked));
+	dmPacked2[efeatureb133] = eflagC;
+	_ASSERT(dmPacked2 != dmPacked);
+
+	tc::packed_dense_map<EFeature, bool> const dmbAll(tc::fill_tag, true);
+	_ASSERT(tc::all_of(dmbAll));
+	_ASSERTEQUAL(*tc::begin(tc::reverse(dmbAll)), true);
+
+	tc::packed_dense_map<EFeature, EState> dmestate;
+	dmestate[efeatureb133] = estateUNKNOWN;
+	_ASSERTEQUAL(tc::back(dmestate), estateUNKNOWN);
+	_ASSERTEQUAL(tc::front(dmestate), estateOFF);
+}
@@ -16,6 +16,7 @@
 
 // Including necessary range headers
 #include "range_adaptor.h"
+#include "subrange.h"
 #include "meta.h"
 #include "range_fwd.h"
 
@@ -44,6 +45,25 @@ namespace tc {
 					? tc::continue_if_not_break(m_sink, std::forward<T>(t))
 					: tc::constant<tc::continue_>()
 			)
+
+			// If the sink takes chunks, runs of kept elements of contiguous ranges are forwarded as chunks.
+			template<typename Rng>
+				requires std::is_lvalue_reference<Rng>::value && tc::contiguous_range<Rng> &&
+					tc::has_mem_fn_chunk<Sink const&, decltype(tc::make_iterator_range(tc::ptr_begin(std::declval<Rng>()), tc::ptr_end(std::declval<Rng>())))>
+			constexpr guaranteed_break_or_continue chunk(Rng&& rng) const& MAYTHROW {
+				auto const Keep = [&](auto const& t) MAYTHROW {
+					return tc::explicit_cast<bool>(tc::invoke(m_pred, tc::as_const(t))); // MAYTHROW
+				};
+				auto pt = tc::ptr_begin(rng);
+				auto const ptEnd = tc::ptr_end(rng);
+				for(;;) {
+					while( pt != ptEnd && !Keep(*pt) ) ++pt;
+					if( pt == ptEnd ) return tc::constant<tc::continue_>();
+					auto const ptRunBegin = pt;
+					do ++pt; while( pt != ptEnd && Keep(*pt) );
+					tc_return_if_break(tc_internal_continue_if_not_break(m_sink.chunk(tc::make_iterator_range(ptRunBegin, pt)))) // MAYTHROW
+				}
+			}
 		};
 
         // filter_adaptor is a range adaptor, that filters the elements of a range
@@ -9,32 +9,138 @@
 #pragma once
 
 #include "../algorithm/algorithm.h"
-#include "../algorithm/sort_streaming.h"
+#include "../container/container.h"
+#include "range_adaptor.h"
 
 namespace tc {
+	namespace merge_many_detail {
+		template<typename RngRng>
+		using view_t = tc::decay_t<decltype(tc::make_view(*std::declval<tc::iterator_t<RngRng const&>>()))>;
+
+		template<typename RngRng>
+		using head_t = decltype(tc::front(std::declval<view_t<RngRng>&>()));
+
+		// The heads of the runs are not cached: for views owning their elements, e.g., tc::ordered_unique_range over a zip, they
+		// refer into the view and would dangle when m_vecrun reallocates or the index is copied.
+		template<typename RngRng>
+		struct run final {
+			view_t<RngRng> m_view;
+		};
+
+		// Loser tree over the runs: run n is the leaf at node c_nRuns + n, the inner nodes 1 to c_nRuns - 1 store the run which lost
+		// the match at that node, m_vecnTree[0] stores the overall winner. Replacing the winner takes one comparison per tree level.
+		template<typename RngRng>
+		struct merge_many_index {
+			tc::vector<run<RngRng>> m_vecrun;
+			tc::vector<std::size_t> m_vecnTree;
+		};
+	}
+
+	namespace no_adl {
+		template<typename RngRng, typename Less, bool bUnique>
+		struct [[nodiscard]] merge_many_adaptor
+			: tc::range_adaptor_base_range<RngRng>
+			, tc::range_iterator_from_index<
+				merge_many_adaptor<RngRng, Less, bUnique>,
+				merge_many_detail::merge_many_index<RngRng>
+			>
+		{
+		private:
+			using this_type = merge_many_adaptor;
+			using head_t = merge_many_detail::head_t<RngRng>;
+		public:
+			using typename this_type::range_iterator_from_index::tc_index;
+			static constexpr bool c_bHasStashingIndex = !std::is_reference<head_t>::value;
+
+			template<typename RngRng_, typename Less_>
+			merge_many_adaptor(RngRng_&& rngrng, Less_&& less) noexcept
+				: tc::range_adaptor_base_range<RngRng>(tc::aggregate_tag, tc_move_if_owned(rngrng))
+				, m_less(tc_move_if_owned(less))
+			{}
+
+		private:
+			// Does run nLhs precede run nRhs in the output? Exhausted runs come last, ties are broken by the position of the run.
+			bool precedes(tc_index const& idx, std::size_t const nLhs, std::size_t const nRhs) const& MAYTHROW {
+				auto const& viewLhs = idx.m_vecrun[nLhs].m_view;
+				auto const& viewRhs = idx.m_vecrun[nRhs].m_view;
+				if( tc::empty(viewLhs) ) return false;
+				if( tc::empty(viewRhs) ) return true;
+				return nLhs < nRhs ? !m_less(tc::front(viewRhs), tc::front(viewLhs)) : m_less(tc::front(viewLhs), tc::front(viewRhs)); // MAYTHROW
+			}
+
+			STATIC_FINAL_MOD(constexpr, begin_index)() const& MAYTHROW -> tc_index {
+				tc_index idx;
+				tc::for_each(this->base_range(), [&](auto&& rng) MAYTHROW {
+					auto view = tc::make_view(tc_move_if_owned(rng));
+					if( !tc::empty(view) ) {
+						tc::cont_emplace_back(idx.m_vecrun, merge_many_detail::run<RngRng>{tc_move(view)});
+					}
+				});
+				auto const nRuns = tc::size_raw(idx.m_vecrun);
+				if( 0 < nRuns ) {
+					// Play all matches bottom-up. vecnWinner[n] is the winner of the subtree below node n.
+					tc::vector<std::size_t> vecnWinner(2 * nRuns);
+					for( std::size_t n = 0; n < nRuns; ++n ) {
+						vecnWinner[nRuns + n] = n;
+					}
+					idx.m_vecnTree.resize(nRuns);
+					for( std::size_t n = nRuns - 1; 0 < n; --n ) {
+						auto nWinner = vecnWinner[2 * n];
+						auto nLoser = vecnWinner[2 * n + 1];
+						if( precedes(idx, nLoser, nWinner) ) tc::swap(nWinner, nLoser);
+						idx.m_vecnTree[n] = nLoser;
+						vecnWinner[n] = nWinner;
+					}
+					idx.m_vecnTree[0] = 1 < nRuns ? vecnWinner[1] : 0;
+				}
+				return idx;
+			}
+
+			STATIC_FINAL_MOD(constexpr, at_end_index)(tc_index const& idx) const& noexcept -> bool {
+				return tc::empty(idx.m_vecrun) || tc::empty(idx.m_vecrun[idx.m_vecnTree[0]].m_view);
+			}
+
+			STATIC_FINAL_MOD(constexpr, dereference_index)(tc_index const& idx) const& noexcept -> decltype(auto) {
+				_ASSERTE(!this->at_end_index(idx));
+				return tc::front(idx.m_vecrun[idx.m_vecnTree[0]].m_view);
+			}
+
+			STATIC_FINAL_MOD(constexpr, increment_index)(tc_index& idx) const& MAYTHROW -> void {
+				_ASSERTE(!this->at_end_index(idx));
+				auto const nRuns = tc::size_raw(idx.m_vecrun);
+				auto const Advance = [&]() MAYTHROW {
+					auto nWinner = idx.m_vecnTree[0];
+					tc::drop_first_inplace(idx.m_vecrun[nWinner].m_view);
+					// Replay the matches on the path from the leaf of the winner to the root.
+					for( auto n = (nRuns + nWinner) / 2; 0 < n; n /= 2 ) {
+						if( precedes(idx, idx.m_vecnTree[n], nWinner) ) tc::swap(idx.m_vecnTree[n], nWinner);
+					}
+					idx.m_vecnTree[0] = nWinner;
+				};
+				if constexpr( bUnique ) {
+					tc::reference_or_value<head_t> const headPrev(tc::aggregate_tag, this->dereference_index(idx));
+					do {
+						Advance(); // MAYTHROW
+					} while( !this->at_end_index(idx) && !m_less(*headPrev, this->dereference_index(idx)) );
+				} else {
+					Advance(); // MAYTHROW
+				}
+			}
+
+			Less m_less;
+		};
+	}
+
+	// Merges the sorted ranges of rngrng into a single sorted range. The merge is stable: equal elements of different ranges
+	// are output in the order of the ranges in rngrng. Each output element costs O(log(number of ranges)) comparisons.
 	template<typename RngRng, typename Less = tc::fn_less>
 	auto merge_many(RngRng&& rngrng, Less&& less = Less()) noexcept {
-		return tc::transform(
-			tc::sort_streaming(
-				tc::filter(
-					tc::transform(
-						std::forward<RngRng>(rngrng),
-						tc_fn(tc::make_view)
-					),
-					tc_fn(!tc::empty)
-				),
-				tc::projected(std::forward<Less>(less), tc::fn_front()),
-				[](auto& rng) noexcept {
-					tc::drop_first_inplace(rng);
-					return !tc::empty(rng);
-				}
-			),
-			tc::fn_front()
-		);
+		return no_adl::merge_many_adaptor<RngRng, tc::decay_t<Less>, /*bUnique*/false>(tc_move_if_owned(rngrng), tc_move_if_owned(less));
 	}
 
+	// Like tc::merge_many, but of each group of equivalent elements, only the first one is output.
 	template<typename RngRng, typename Less = tc::fn_less>
 	auto merge_many_unique(RngRng&& rngrng, Less&& less = Less()) noexcept {
-		return tc::ordered_unique(tc::merge_many(std::forward<RngRng>(rngrng), less), less);
+		return no_adl::merge_many_adaptor<RngRng, tc::decay_t<Less>, /*bUnique*/true>(tc_move_if_owned(rngrng), tc_move_if_owned(less));
 	}
 }
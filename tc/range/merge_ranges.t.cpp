@@ -140,3 +140,75 @@ UNITTESTDEF(merge_ranges_with_unique_range_2) {
 	_ASSERTEQUAL(vecvecn2[4][0],6);
 	_ASSERTEQUAL(vecvecn2[4][1],7);
 }
+
+UNITTESTDEF(merge_many_loser_tree) {
+	tc::vector<tc::vector<tc::tuple<int, int>>> vecvecpairn;
+	std::size_t nTotal = 0;
+	for( int nRun = 0; nRun < 13; ++nRun ) {
+		tc::vector<tc::tuple<int, int>> vecpairn;
+		for( int n = nRun; n < 200; n += nRun + 1 ) {
+			tc::cont_emplace_back(vecpairn, n / 3, nRun);
+			++nTotal;
+		}
+		tc::cont_emplace_back(vecvecpairn, tc_move(vecpairn));
+	}
+	tc::cont_emplace_back(vecvecpairn); // empty runs are skipped
+	auto const lessFirst = tc::projected(tc::fn_less(), tc_fn(tc::get<0>));
+
+	// stable, and O(log(number of runs)) comparisons per element
+	int nCompares = 0;
+	auto const vecpairn = tc::make_vector(tc::merge_many(vecvecpairn, [&](auto const& lhs, auto const& rhs) noexcept {
+		++nCompares;
+		return lessFirst(lhs, rhs);
+	}));
+	_ASSERTEQUAL(tc::size(vecpairn), nTotal);
+	_ASSERT(tc::is_sorted(vecpairn, tc::fn_less()));
+	_ASSERT(nCompares <= tc::size(vecpairn) * 4 + 13);
+
+	// iterator traversal
+	auto rng = tc::merge_many(vecvecpairn, lessFirst);
+	auto it = tc::begin(rng);
+	STATICASSERTSAME((decltype(*it)), (tc::tuple<int, int>&)); // elements are references into the runs
+	tc::for_each(vecpairn, [&](auto const& pairn) noexcept {
+		_ASSERT(tc::end(rng) != it);
+		_ASSERTEQUAL(*it, pairn);
+		++it;
+	});
+	_ASSERT(tc::end(rng) == it);
+
+	_ASSERT(tc::equal(tc::merge_many_unique(vecvecpairn, lessFirst), tc::transform(tc::iota(0, 67), [](int const n) noexcept {
+		return tc::make_tuple(n, 0);
+	})));
+	_ASSERT(tc::empty(tc::merge_many(tc::vector<tc::vector<int>>())));
+}
+
+UNITTESTDEF(merge_many_owning_runs) {
+	// The runs are views owning their elements, which move when the vector of runs grows.
+	auto const rngrngn = tc::transform(tc::iota(0, 40), [](int const n) noexcept {
+		return tc::make_array(tc::aggregate_tag, n, n + 40, n + 80);
+	});
+	_ASSERT(tc::equal(tc::merge_many(rngrngn), tc::iota(0, 120)));
+	_ASSERT(tc::equal(tc::merge_many_unique(rngrngn, tc::projected(tc::fn_less(), [](int const n) noexcept { return n / 2; })), tc::transform(tc::iota(0, 60), [](int const n) noexcept {
+		return 2 * n;
+	})));
+
+	// The heads of ordered_unique_range over a zip refer into the run owning the zip.
+	tc::vector<tc::vector<int>> vecvecn;
+	for( int n = 0; n < 20; ++n ) {
+		tc::cont_emplace_back(vecvecn, std::initializer_list<int>{n, n, n + 20});
+	}
+	auto const lesspred = tc::projected(tc::fn_less(), tc_fn(tc::get<0>));
+	auto rng = tc::merge_many(
+		tc::transform(tc::iota(0, 20), [&](int const n) noexcept {
+			return tc::ordered_unique_range(tc::zip(tc::make_view(vecvecn[n]), tc::make_view(vecvecn[n])), lesspred);
+		}),
+		tc::projected(lesspred, tc::fn_front())
+	);
+	int nGroups = 0;
+	tc::for_each(rng, [&](auto const& rngpairn) noexcept {
+		_ASSERTEQUAL(tc::get<0>(tc::front(rngpairn)), nGroups);
+		_ASSERTEQUAL(tc::size(rngpairn), nGroups < 20 ? 2 : 1);
+		++nGroups;
+	});
+	_ASSERTEQUAL(nGroups, 40);
+}
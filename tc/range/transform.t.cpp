@@ -11,6 +11,8 @@
 #include "../algorithm/element.h"
 #include "../algorithm/size.h"
 #include "../array.h"
+#include "../algorithm/append.h"
+#include "../algorithm/equal.h"
 #include "filter_adaptor.h"
 #include "transform_adaptor.h"
 
@@ -70,3 +72,48 @@ UNITTESTDEF(vector_int_ref_need_sfinae_transform) {
 	_ASSERTEQUAL(*it++,4);
 	_ASSERTEQUAL(*it++,9);
 }
+
+namespace {
+	struct chunk_recorder final {
+		using guaranteed_break_or_continue = tc::constant<tc::continue_>;
+		tc::vector<int>* m_pvecn;
+		tc::vector<std::size_t>* m_pvecnChunkSize;
+
+		void operator()(int const n) const& noexcept {
+			tc::cont_emplace_back(*m_pvecn, n);
+			tc::cont_emplace_back(*m_pvecnChunkSize, 1);
+		}
+
+		template<tc::contiguous_range Rng>
+		void chunk(Rng const& rng) const& noexcept {
+			tc::for_each(rng, [&](int const n) noexcept { tc::cont_emplace_back(*m_pvecn, n); });
+			tc::cont_emplace_back(*m_pvecnChunkSize, tc::size_raw(rng));
+		}
+	};
+}
+
+UNITTESTDEF(filter_transform_chunk) {
+	tc::vector<int> vecn;
+	tc::vector<std::size_t> vecnChunkSize;
+	tc::vector<int> const vecnSource{1, 2, 4, 6, 7, 8, 10, 11};
+
+	// runs of kept elements are forwarded as chunks
+	tc::for_each(tc::filter(vecnSource, [](int const n) noexcept { return 0 == n % 2; }), chunk_recorder{&vecn, &vecnChunkSize});
+	_ASSERTEQUAL(vecn, (tc::vector<int>{2, 4, 6, 8, 10}));
+	_ASSERTEQUAL(vecnChunkSize, (tc::vector<std::size_t>{3, 2}));
+
+	// transformed values are forwarded in batches
+	vecn.clear();
+	vecnChunkSize.clear();
+	tc::vector<int> vecnLarge;
+	for( int n = 0; n < 1000; ++n ) tc::cont_emplace_back(vecnLarge, n);
+	tc::for_each(tc::transform(tc::filter(vecnLarge, [](int const n) noexcept { return 0 != n % 100; }), [](int const n) noexcept { return 2 * n; }), chunk_recorder{&vecn, &vecnChunkSize});
+	_ASSERTEQUAL(tc::size(vecn), 990);
+	_ASSERT(tc::equal(vecn, tc::transform(tc::filter(vecnLarge, [](int const n) noexcept { return 0 != n % 100; }), [](int const n) noexcept { return 2 * n; })));
+	_ASSERT(tc::size(vecnChunkSize) < 10);
+
+	_ASSERTEQUAL(
+		tc::make_vector(tc::transform(tc::filter(vecnSource, [](int const n) noexcept { return 1 == n % 2; }), [](int const n) noexcept { return n + 1; })),
+		(tc::vector<int>{2, 8, 12})
+	);
+}
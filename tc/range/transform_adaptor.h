@@ -31,6 +31,29 @@ namespace tc {
 			constexpr auto operator()(T&& t) const& return_decltype_MAYTHROW(
 				tc::invoke(m_sink, tc::invoke(m_func, std::forward<T>(t)))
 			)
+
+			// If the sink never breaks and takes chunks, trivial transformed values are collected in batches, which are forwarded as chunks.
+			// A batch takes at most 4 KB of stack, or a single value.
+			template<typename Rng, typename Value = decltype(tc::invoke(std::declval<Func const&>(), *tc::as_lvalue(tc::begin(std::declval<Rng>()))))>
+				requires std::is_trivial<Value>::value &&
+					std::is_same<tc::constant<tc::continue_>, guaranteed_break_or_continue_t<Sink>>::value &&
+					tc::has_mem_fn_chunk<Sink const&, decltype(tc::make_iterator_range(std::declval<Value*>(), std::declval<Value*>()))>
+			constexpr tc::constant<tc::continue_> chunk(Rng&& rng) const& MAYTHROW {
+				constexpr std::size_t c_nBatch = tc::max(std::size_t(1), 4096 / sizeof(Value));
+				Value aval[c_nBatch];
+				std::size_t nval = 0;
+				tc::for_each(std::forward<Rng>(rng), [&](auto&& t) MAYTHROW {
+					aval[nval] = tc::invoke(m_func, tc_move_if_owned(t)); // MAYTHROW
+					if( c_nBatch == ++nval ) {
+						m_sink.chunk(tc::make_iterator_range(tc::begin(aval), tc::end(aval))); // MAYTHROW
+						nval = 0;
+					}
+				});
+				if( 0 < nval ) {
+					m_sink.chunk(tc::make_iterator_range(tc::begin(aval), tc::begin(aval) + nval)); // MAYTHROW
+				}
+				return tc::constant<tc::continue_>();
+			}
 		};
 	}
 
@@ -0,0 +1,282 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/enum.h"
+#include "base/invoke_with_constant.h"
+#include "base/reference_or_value.h"
+#include "algorithm/for_each.h"
+#include "algorithm/size.h"
+#include "range/subrange.h"
+#include "container/container.h"
+#include "container/cont_reserve.h"
+#include "container/insert.h"
+#include "dense_map.h"
+#include "interval.h"
+#include "static_vector.h"
+#include "tuple.h"
+
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <variant>
+
+// Binary serialization in native byte order:
+// - arithmetic types as their object representation, bool as one byte 0 or 1,
+// - enums as their underlying type,
+// - tc::tuple elements and tc::dense_map values, including tc::interval, one after the other,
+// - std::optional as bool followed by the value if there is one, like tc::bool_prefixed,
+// - std::variant as std::uint32_t index followed by the alternative,
+// - other ranges as std::uint32_t size followed by the elements, like tc::size_prefixed. Arrays of arithmetic types other
+//   than bool are aligned to their element type relative to the beginning of the serialization, so that tc::deserializer
+//   can return them as tc::span into the buffer without copying.
+namespace tc {
+	struct deserialize_exception final {};
+
+	namespace serialize_detail {
+		// Types which are read and written as their object representation, and may be viewed in place.
+		template<typename T>
+		concept viewable = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+
+		template<typename T>
+		struct is_viewable_span final : tc::constant<false> {};
+
+		template<viewable T>
+		struct is_viewable_span<tc::span<T const>> final : tc::constant<true> {};
+
+		template<typename T>
+		concept dense_map_like = requires { typename T::dense_map_key_type; };
+
+		template<typename T>
+		concept sized_range = tc::range_with_iterators<T> && !dense_map_like<T> && !tc::instance<T, tc::tuple>;
+
+		// tc::static_vector
+		template<typename T>
+		concept fixed_capacity = requires { { T::capacity() } -> std::convertible_to<std::size_t>; };
+
+		inline constexpr unsigned char c_abPadding[alignof(std::max_align_t)] = {};
+
+		template<typename T>
+		[[nodiscard]] constexpr std::size_t padding(std::size_t const nOffset) noexcept {
+			return (alignof(T) - nOffset % alignof(T)) % alignof(T);
+		}
+
+		template<typename Sink>
+		struct serializer final {
+			explicit serializer(Sink& sink) noexcept : m_sink(sink) {}
+
+			template<typename T>
+			void write(T const& t) & MAYTHROW {
+				if constexpr( std::is_same<T, bool>::value ) {
+					write(static_cast<std::uint8_t>(t ? 1 : 0));
+				} else if constexpr( viewable<T> ) {
+					write_blob(tc::as_blob(t));
+				} else if constexpr( std::is_enum<T>::value ) {
+					write(tc::to_underlying(t));
+				} else if constexpr( tc::instance<T, std::optional> ) {
+					write(tc::explicit_cast<bool>(t));
+					if( t ) write(*t);
+				} else if constexpr( tc::instance<T, std::variant> ) {
+					_ASSERT(!t.valueless_by_exception());
+					write(static_cast<std::uint32_t>(t.index()));
+					std::visit([&](auto const& alt) MAYTHROW { write(alt); }, t);
+				} else if constexpr( tc::instance<T, tc::tuple> ) {
+					tc::for_each(t, [&](auto const& elem) MAYTHROW { write(elem); });
+				} else if constexpr( dense_map_like<T> ) {
+					tc::for_each(t, [&](auto const& val) MAYTHROW { write(val); });
+				} else {
+					static_assert( sized_range<T>, "tc::serialize does not support this type" );
+					write(tc::explicit_cast<std::uint32_t>(tc::size(t)));
+					using value_type = tc::range_value_t<T const&>;
+					if constexpr( viewable<value_type> ) {
+						write_blob(tc::make_iterator_range(c_abPadding, c_abPadding + padding<value_type>(m_nOffset)));
+						if constexpr( tc::contiguous_range<T const&> ) {
+							write_blob(tc::range_as_blob(t));
+						} else {
+							tc::for_each(t, [&](value_type const val) MAYTHROW { write(val); });
+						}
+					} else {
+						tc::for_each(t, [&](auto const& elem) MAYTHROW { write(elem); });
+					}
+				}
+			}
+
+		private:
+			template<typename Rng>
+			void write_blob(Rng const& rngb) & MAYTHROW {
+				m_nOffset += tc::size(rngb);
+				tc::for_each(rngb, m_sink); // MAYTHROW
+			}
+
+			Sink& m_sink;
+			std::size_t m_nOffset = 0;
+		};
+	}
+
+	namespace no_adl {
+		template<typename T>
+		struct [[nodiscard]] serialize_impl final {
+			friend auto range_output_t_impl(serialize_impl const&) -> tc::type::list<unsigned char const&>; // declaration only
+
+			template<typename Rhs>
+			serialize_impl(aggregate_tag_t, Rhs&& rhs) noexcept
+				: m_t(aggregate_tag, std::forward<Rhs>(rhs))
+			{}
+
+			template<typename Sink>
+			void operator()(Sink sink) const& MAYTHROW {
+				serialize_detail::serializer<Sink> serializer(sink);
+				serializer.write(*m_t); // MAYTHROW
+			}
+
+		private:
+			tc::reference_or_value<T> m_t;
+		};
+
+		// Reads values from a buffer written by tc::serialize. Strings and other arrays of arithmetic types can be read as
+		// tc::span into the buffer, which must then outlive the span and be aligned to max_align_t like a heap allocation. Throws
+		// tc::deserialize_exception on malformed input or if a span cannot be viewed because the buffer is misaligned.
+		struct [[nodiscard]] deserializer final {
+			template<typename Rng>
+			explicit deserializer(Rng const& rngb) noexcept
+				: m_pbBegin(tc::ptr_begin(tc::range_as_blob(rngb)))
+				, m_pb(m_pbBegin)
+				, m_pbEnd(tc::ptr_end(tc::range_as_blob(rngb)))
+			{}
+
+			[[nodiscard]] bool empty() const& noexcept { return m_pb == m_pbEnd; }
+
+			template<typename T>
+			[[nodiscard]] T read() & THROW(tc::deserialize_exception) {
+				if constexpr( std::is_same<T, bool>::value ) {
+					switch( read<std::uint8_t>() ) {
+						case 0: return false;
+						case 1: return true;
+						default: throw tc::deserialize_exception();
+					}
+				} else if constexpr( serialize_detail::viewable<T> ) {
+					T t;
+					std::memcpy(std::addressof(t), take(sizeof(T)), sizeof(T));
+					return t;
+				} else if constexpr( std::is_enum<T>::value ) {
+					auto const n = read<std::underlying_type_t<T>>();
+					if( !tc::is_enum_value<T>(n) ) throw tc::deserialize_exception();
+					return static_cast<T>(n);
+				} else if constexpr( tc::instance<T, std::optional> ) {
+					if( read<bool>() ) {
+						return T(std::in_place, read<typename T::value_type>());
+					} else {
+						return std::nullopt;
+					}
+				} else if constexpr( tc::instance<T, std::variant> ) {
+					auto const nIndex = read<std::uint32_t>();
+					if( std::variant_size<T>::value <= nIndex ) throw tc::deserialize_exception();
+					return tc::invoke_with_constant<std::make_index_sequence<std::variant_size<T>::value>>(
+						[&](auto const nconstIndex) MAYTHROW -> T {
+							return T(std::in_place_index<nconstIndex()>, read<std::variant_alternative_t<nconstIndex(), T>>());
+						},
+						nIndex
+					);
+				} else if constexpr( tc::instance<T, tc::tuple> ) {
+					return read_tuple<T>(std::make_index_sequence<std::tuple_size<T>::value>());
+				} else if constexpr( serialize_detail::dense_map_like<T> ) {
+					return T(tc::func_tag, [&](auto const&) MAYTHROW { return read<tc::range_value_t<T const&>>(); });
+				} else if constexpr( serialize_detail::is_viewable_span<T>::value ) {
+					using value_type = tc::range_value_t<T>;
+					auto const [pb, n] = read_array<value_type>();
+					// Spans are aligned relative to the beginning of the serialization, so they can only be viewed in an aligned buffer.
+					if( !aligned<value_type>(pb) ) throw tc::deserialize_exception();
+					auto const pBegin = reinterpret_cast<value_type const*>(pb);
+					return tc::make_iterator_range(pBegin, pBegin + n);
+				} else {
+					static_assert( serialize_detail::sized_range<T>, "tc::deserialize does not support this type" );
+					using value_type = tc::range_value_t<T const&>;
+					if constexpr( serialize_detail::viewable<value_type> ) {
+						auto const [pb, n] = read_array<value_type>();
+						if constexpr( serialize_detail::fixed_capacity<T> ) {
+							if( T::capacity() < n ) throw tc::deserialize_exception();
+						}
+						if( aligned<value_type>(pb) ) {
+							auto const pBegin = reinterpret_cast<value_type const*>(pb);
+							return tc::explicit_cast<T>(tc::make_iterator_range(pBegin, pBegin + n));
+						} else {
+							T cont;
+							tc::cont_reserve(cont, n);
+							for( std::size_t i = 0; i < n; ++i ) {
+								value_type t;
+								std::memcpy(std::addressof(t), pb + i * sizeof(value_type), sizeof(value_type));
+								tc::cont_emplace_back(cont, t);
+							}
+							return cont;
+						}
+					} else {
+						auto const n = read<std::uint32_t>();
+						if constexpr( serialize_detail::fixed_capacity<T> ) {
+							if( T::capacity() < n ) throw tc::deserialize_exception();
+						}
+						T cont;
+						// Every element takes at least one byte, unless it is empty, so a corrupt size cannot make us reserve too much.
+						tc::cont_reserve(cont, tc::min(n, static_cast<std::size_t>(m_pbEnd - m_pb)));
+						for( auto i = n; 0 < i; --i ) {
+							tc::cont_emplace_back(cont, read<value_type>());
+						}
+						return cont;
+					}
+				}
+			}
+
+		private:
+			unsigned char const* take(std::size_t const n) & THROW(tc::deserialize_exception) {
+				if( static_cast<std::size_t>(m_pbEnd - m_pb) < n ) throw tc::deserialize_exception();
+				auto const pb = m_pb;
+				m_pb += n;
+				return pb;
+			}
+
+			// Reads the size of an array of viewable values, skips the padding and returns the object representation of the values.
+			template<typename T>
+			std::pair<unsigned char const*, std::uint32_t> read_array() & THROW(tc::deserialize_exception) {
+				auto const n = read<std::uint32_t>();
+				take(serialize_detail::padding<T>(m_pb - m_pbBegin));
+				if( static_cast<std::size_t>(m_pbEnd - m_pb) / sizeof(T) < n ) throw tc::deserialize_exception();
+				return std::make_pair(take(n * sizeof(T)), n);
+			}
+
+			template<typename T>
+			static bool aligned(unsigned char const* const pb) noexcept {
+				return 0 == reinterpret_cast<std::uintptr_t>(pb) % alignof(T);
+			}
+
+			template<typename T, std::size_t... I>
+			T read_tuple(std::index_sequence<I...>) & THROW(tc::deserialize_exception) {
+				return T{{ {read<std::tuple_element_t<I, T>>()}... }}; // braced initialization reads the elements in order
+			}
+
+			unsigned char const* m_pbBegin;
+			unsigned char const* m_pb;
+			unsigned char const* m_pbEnd;
+		};
+	}
+	using no_adl::deserializer;
+
+	template<typename T>
+	auto serialize(T&& t) return_ctor_noexcept(
+		no_adl::serialize_impl<T>,
+		(aggregate_tag, std::forward<T>(t))
+	)
+
+	// Reads a T which must span all of rngb.
+	template<typename T, typename Rng>
+	[[nodiscard]] T deserialize(Rng const& rngb) THROW(tc::deserialize_exception) {
+		tc::deserializer deserializer(rngb);
+		auto t = deserializer.read<T>(); // THROW(tc::deserialize_exception)
+		if( !deserializer.empty() ) throw tc::deserialize_exception();
+		return t;
+	}
+}
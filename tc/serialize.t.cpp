@@ -0,0 +1,133 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "algorithm/append.h"
+#include "algorithm/equal.h"
+#include "string/format.h"
+#include "serialize.h"
+
+namespace {
+	TC_DEFINE_ENUM(EFruit, efruit, (APPLE)(PEAR)(PLUM))
+
+	template<typename T>
+	tc::vector<unsigned char> serialized(T const& t) noexcept {
+		return tc::make_vector(tc::serialize(t));
+	}
+
+	template<typename T, typename Rng>
+	bool deserialize_throws(Rng const& rngb) noexcept {
+		try {
+			static_cast<void>(tc::deserialize<T>(rngb));
+			return false;
+		} catch( tc::deserialize_exception const& ) {
+			return true;
+		}
+	}
+}
+
+UNITTESTDEF(serialize_roundtrip) {
+	using snapshot_t = tc::tuple<
+		int,
+		EFruit,
+		std::optional<tc::string<char>>,
+		std::optional<double>,
+		std::variant<int, tc::vector<double>>,
+		tc::vector<tc::tuple<short, bool>>,
+		tc::dense_map<EFruit, unsigned char>,
+		tc::interval<int>
+	>;
+	snapshot_t const snapshot{{
+		{-17},
+		{efruitPEAR},
+		{tc::string<char>("apple pie")},
+		{std::nullopt},
+		{tc::vector<double>{1.5, -2.25}},
+		{tc::vector<tc::tuple<short, bool>>{tc::make_tuple(short(1), true), tc::make_tuple(short(-2), false)}},
+		{tc::dense_map<EFruit, unsigned char>(1, 2, 3)},
+		{tc::interval<int>(3, 9)}
+	}};
+	auto const vecb = serialized(snapshot);
+	auto const snapshotLoaded = tc::deserialize<snapshot_t>(vecb);
+	_ASSERT(tc::get<0>(snapshotLoaded) == tc::get<0>(snapshot));
+	_ASSERT(tc::get<1>(snapshotLoaded) == tc::get<1>(snapshot));
+	_ASSERT(tc::get<2>(snapshotLoaded) == tc::get<2>(snapshot));
+	_ASSERT(tc::get<3>(snapshotLoaded) == tc::get<3>(snapshot));
+	_ASSERT(tc::get<4>(snapshotLoaded) == tc::get<4>(snapshot));
+	_ASSERT(tc::get<5>(snapshotLoaded) == tc::get<5>(snapshot));
+	_ASSERT(tc::get<6>(snapshotLoaded) == tc::get<6>(snapshot));
+	_ASSERT(tc::get<7>(snapshotLoaded) == tc::get<7>(snapshot));
+
+	// truncated input
+	for( std::size_t n = 0; n < tc::size(vecb); ++n ) {
+		_ASSERT(deserialize_throws<snapshot_t>(tc::begin_next<tc::return_take>(vecb, n)));
+	}
+	// trailing input
+	auto vecbLonger = vecb;
+	tc::cont_emplace_back(vecbLonger, 0);
+	_ASSERT(deserialize_throws<snapshot_t>(vecbLonger));
+}
+
+UNITTESTDEF(serialize_format) {
+	// strings are compatible with tc::size_prefixed, optionals with tc::bool_prefixed
+	tc::string<char> const str("snapshot");
+	_ASSERT(tc::equal(serialized(str), tc::make_vector(tc::size_prefixed(str))));
+	std::optional<int> const on(5);
+	_ASSERT(tc::equal(serialized(on), tc::make_vector(tc::bool_prefixed(on))));
+
+	_ASSERT(deserialize_throws<bool>(tc::make_vector(tc::as_blob(std::uint8_t(2)))));
+	_ASSERT(deserialize_throws<EFruit>(tc::make_vector(tc::as_blob(tc::to_underlying(tc::contiguous_enum<EFruit>::end())))));
+	_ASSERT(deserialize_throws<std::variant<int, char>>(tc::make_vector(tc::as_blob(std::uint32_t(2)), tc::as_blob(0))));
+	_ASSERT(deserialize_throws<tc::vector<int>>(tc::make_vector(tc::as_blob(std::uint32_t(0x40000000)))));
+}
+
+UNITTESTDEF(deserialize_span) {
+	auto const tpl = tc::make_tuple(tc::string<char>("abc"), tc::vector<double>{0.5, 1.5, 2.5}, tc::vector<std::uint16_t>{4, 5});
+	auto const vecb = serialized(tpl);
+
+	tc::deserializer deserializer(vecb);
+	auto const spanch = deserializer.read<tc::span<char const>>();
+	auto const spand = deserializer.read<tc::span<double const>>();
+	auto const spann = deserializer.read<tc::span<std::uint16_t const>>();
+	_ASSERT(deserializer.empty());
+
+	// the spans point into the buffer
+	_ASSERT(tc::ptr_begin(tc::range_as_blob(vecb)) < tc::range_as_blob(spanch).begin());
+	_ASSERT(tc::range_as_blob(spann).end() == tc::ptr_end(tc::range_as_blob(vecb)));
+	_ASSERT(0 == reinterpret_cast<std::uintptr_t>(tc::ptr_begin(spand)) % alignof(double));
+	_ASSERT(tc::equal(spanch, tc::get<0>(tpl)));
+	_ASSERT(tc::equal(spand, tc::get<1>(tpl)));
+	_ASSERT(tc::equal(spann, tc::get<2>(tpl)));
+}
+
+UNITTESTDEF(deserialize_unaligned) {
+	// Only spans need an aligned buffer, other values are copied out.
+	auto const tpl = tc::make_tuple(std::uint64_t(0x123456789abcdef0), 2.5, true);
+	using tuple_t = std::remove_const_t<decltype(tpl)>;
+	tc::vector<unsigned char> vecb{0};
+	tc::append(vecb, serialized(tpl));
+	_ASSERT(tc::deserialize<tuple_t>(tc::make_iterator_range(vecb.data() + 1, vecb.data() + vecb.size())) == tpl);
+
+	// Arrays are copied out element by element, but cannot be viewed as misaligned spans.
+	tc::vector<double> const vecd{0.5, 1.5, 2.5};
+	vecb = tc::vector<unsigned char>{0};
+	tc::append(vecb, serialized(vecd));
+	auto const rngbUnaligned = tc::make_iterator_range(vecb.data() + 1, vecb.data() + vecb.size());
+	_ASSERT(tc::equal(tc::deserialize<tc::vector<double>>(rngbUnaligned), vecd));
+	_ASSERT(deserialize_throws<tc::span<double const>>(rngbUnaligned));
+}
+
+#if defined(__clang__) || defined(_MSC_VER) // GCC 12: "sorry, unimplemented: mangling noexcept_expr" in static_vector::emplace_back
+UNITTESTDEF(serialize_static_vector) {
+	tc::static_vector<tc::tuple<int, bool>, 4> const vectpl(tc::aggregate_tag, tc::make_tuple(7, true), tc::make_tuple(8, false));
+	_ASSERT(tc::equal(tc::deserialize<tc::static_vector<tc::tuple<int, bool>, 4>>(serialized(vectpl)), vectpl));
+	tc::static_vector<int, 4> const vecn(tc::aggregate_tag, 1, 2, 3);
+	_ASSERT(tc::equal(tc::deserialize<tc::static_vector<int, 3>>(serialized(vecn)), vecn));
+	_ASSERT(deserialize_throws<tc::static_vector<int, 2>>(serialized(vecn)));
+}
+#endif
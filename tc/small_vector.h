@@ -0,0 +1,257 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "static_vector.h"
+#include "storage_for.h"
+#include "algorithm/filter_inplace.h"
+#include "algorithm/append.h"
+#include "algorithm/minmax.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace tc {
+	namespace small_vector_adl {
+		// Like tc::static_vector, keeps up to N elements inline, but moves them to the heap instead of asserting when it
+		// grows larger. The elements are contiguous in either case, so tc::append copies random-access chunks in one go.
+		template< typename T, tc::static_vector_size_t N >
+		struct [[nodiscard]] small_vector final {
+			static_assert( 0 < N );
+			// Elements are moved when the vector spills to the heap and when it is moved from while inline.
+			static_assert( std::is_nothrow_move_constructible<T>::value );
+
+			using size_type = tc::static_vector_size_t;
+			using difference_type = std::ptrdiff_t;
+			using value_type = T;
+			using reference = T&;
+			using const_reference = T const&;
+			using iterator = T*;
+			using const_iterator = T const*;
+
+			small_vector() noexcept {}
+
+			template <typename... Args> requires (0 < sizeof...(Args))
+			explicit small_vector(tc::aggregate_tag_t, Args&& ... args) MAYTHROW {
+				// There is no destructor call for a throwing constructor, and the members do not free the heap storage themselves.
+				try {
+					reserve(sizeof...(Args)); // MAYTHROW
+					(tc::cont_emplace_back(*this, std::forward<Args>(args)), ...); // cont_emplace_back for lazy explicit_cast
+				} catch( ... ) {
+					clear();
+					deallocate();
+					throw;
+				}
+			}
+
+			small_vector(small_vector const& vec) MAYTHROW {
+				try {
+					tc::append(*this, vec); // MAYTHROW
+				} catch( ... ) {
+					clear();
+					deallocate();
+					throw;
+				}
+			}
+
+			small_vector(small_vector&& vec) noexcept {
+				steal(vec);
+			}
+
+			small_vector& operator=(small_vector const& vec) & MAYTHROW {
+				if( std::addressof(vec)!=this ) {
+					clear();
+					tc::append(*this, vec); // MAYTHROW
+				}
+				return *this;
+			}
+
+			small_vector& operator=(small_vector&& vec) & noexcept {
+				_ASSERTE( std::addressof(vec)!=this ); // self assignment from rvalues should not happen, rvalues must be expiring
+				clear();
+				deallocate();
+				steal(vec);
+				return *this;
+			}
+
+			~small_vector() {
+				clear();
+				deallocate();
+			}
+
+			[[nodiscard]] T* begin() & noexcept { return m_pt; }
+			[[nodiscard]] T const* begin() const& noexcept { return m_pt; }
+			[[nodiscard]] T* end() & noexcept { return m_pt + m_n; }
+			[[nodiscard]] T const* end() const& noexcept { return m_pt + m_n; }
+			[[nodiscard]] T* data() & noexcept { return m_pt; }
+			[[nodiscard]] T const* data() const& noexcept { return m_pt; }
+
+			[[nodiscard]] size_type size() const& noexcept { return m_n; }
+			[[nodiscard]] bool empty() const& noexcept { return 0 == m_n; }
+			[[nodiscard]] size_type capacity() const& noexcept { return m_nCapacity; }
+			[[nodiscard]] bool is_inline() const& noexcept { return inline_data() == m_pt; }
+
+			[[nodiscard]] T& operator[](size_type const i) & noexcept {
+				_ASSERTDEBUG(i < m_n);
+				return m_pt[i];
+			}
+
+			[[nodiscard]] T const& operator[](size_type const i) const& noexcept {
+				_ASSERTDEBUG(i < m_n);
+				return m_pt[i];
+			}
+
+			void reserve(size_type const n) & MAYTHROW {
+				if( m_nCapacity < n ) {
+					relocate(allocate(n), n); // MAYTHROW
+				}
+			}
+
+			template<typename... Args>
+			T& emplace_back(Args&& ... args) & MAYTHROW {
+				if( m_n == m_nCapacity ) {
+					// Construct the new element before moving the others, args may refer to them.
+					auto const nCapacity = grown_capacity(m_n + 1);
+					T* const pt = allocate(nCapacity); // MAYTHROW
+					try {
+						std::construct_at(pt + m_n, std::forward<Args>(args)...); // MAYTHROW
+					} catch( ... ) {
+						std::allocator<T>().deallocate(pt, nCapacity);
+						throw;
+					}
+					relocate(pt, nCapacity);
+				} else {
+					std::construct_at(m_pt + m_n, std::forward<Args>(args)...); // MAYTHROW
+				}
+				return m_pt[m_n++];
+			}
+
+			void push_back(T const& t) & MAYTHROW {
+				emplace_back(t); // MAYTHROW
+			}
+
+			void push_back(T&& t) & MAYTHROW {
+				emplace_back(tc_move(t)); // MAYTHROW
+			}
+
+			void pop_back() & noexcept {
+				_ASSERTE( 0 < m_n );
+				--m_n;
+				std::destroy_at(m_pt + m_n);
+			}
+
+			// [itBegin, itEnd) may refer to elements of this vector, e.g., in tc::append(vec, vec).
+			template<typename It>
+			T* insert(T const* const itPos, It const itBegin, It const itEnd) & MAYTHROW {
+				auto const nPos = itPos - m_pt;
+				auto const n = tc::explicit_cast<size_type>(std::distance(itBegin, itEnd));
+				if( m_nCapacity - m_n < n ) {
+					// Like emplace_back, copy the new elements before moving the others and freeing their storage.
+					auto const nCapacity = grown_capacity(m_n + n);
+					T* const pt = allocate(nCapacity); // MAYTHROW
+					try {
+						std::uninitialized_copy(itBegin, itEnd, pt + nPos); // MAYTHROW
+					} catch( ... ) {
+						std::allocator<T>().deallocate(pt, nCapacity);
+						throw;
+					}
+					std::uninitialized_move(m_pt, m_pt + nPos, pt);
+					std::uninitialized_move(m_pt + nPos, end(), pt + nPos + n);
+					std::destroy(m_pt, end());
+					deallocate();
+					m_pt = pt;
+					m_nCapacity = nCapacity;
+					m_n += n;
+				} else {
+					std::uninitialized_copy(itBegin, itEnd, end()); // MAYTHROW
+					m_n += n;
+					std::rotate(m_pt + nPos, end() - n, end());
+				}
+				return m_pt + nPos;
+			}
+
+			void clear() & noexcept {
+				take_inplace(m_pt);
+			}
+
+			void resize(size_type const n) & MAYTHROW {
+				if( m_n < n ) {
+					reserve(n); // MAYTHROW
+					do {
+						emplace_back(); // MAYTHROW
+					} while( n != m_n );
+				} else {
+					take_inplace(m_pt + n);
+				}
+			}
+
+			void take_inplace(T const* const it) & noexcept {
+				_ASSERTE( m_pt <= it && it <= end() );
+				auto const n = tc::explicit_cast<size_type>(it - m_pt);
+				std::destroy(m_pt + n, end());
+				m_n = n;
+			}
+
+			void drop_inplace(T const* const it) & noexcept {
+				_ASSERTE( m_pt <= it && it <= end() );
+				take_inplace(std::move(m_pt + (it - m_pt), end(), m_pt));
+			}
+
+		private:
+			T* inline_data() & noexcept { return m_aot[0].uninitialized_addressof(); }
+			T const* inline_data() const& noexcept { return m_aot[0].uninitialized_addressof(); }
+
+			size_type grown_capacity(size_type const n) const& noexcept {
+				return tc::max(n, m_nCapacity * 2);
+			}
+
+			static T* allocate(size_type const n) MAYTHROW {
+				return std::allocator<T>().allocate(n); // MAYTHROW
+			}
+
+			void deallocate() & noexcept {
+				if( !is_inline() ) {
+					std::allocator<T>().deallocate(m_pt, m_nCapacity);
+					m_pt = inline_data();
+					m_nCapacity = N;
+				}
+			}
+
+			// Moves the elements to heap storage pt.
+			void relocate(T* const pt, size_type const nCapacity) & noexcept {
+				std::uninitialized_move(m_pt, end(), pt);
+				std::destroy(m_pt, end());
+				deallocate();
+				m_pt = pt;
+				m_nCapacity = nCapacity;
+			}
+
+			void steal(small_vector& vec) & noexcept {
+				if( vec.is_inline() ) {
+					std::uninitialized_move(vec.m_pt, vec.end(), m_pt);
+					m_n = vec.m_n;
+					vec.clear();
+				} else {
+					m_pt = std::exchange(vec.m_pt, vec.inline_data());
+					m_n = std::exchange(vec.m_n, 0);
+					m_nCapacity = std::exchange(vec.m_nCapacity, N);
+				}
+			}
+
+			// Same inline storage as tc::static_vector for non-trivial types. It is only accessed through m_pt.
+			tc::storage_for_without_dtor<T> m_aot[N];
+			T* m_pt = inline_data();
+			size_type m_n = 0;
+			size_type m_nCapacity = N;
+		};
+	} // small_vector_adl
+	using small_vector_adl::small_vector;
+
+	template< typename T, tc::static_vector_size_t N >
+	struct range_filter_by_move_element<tc::small_vector<T,N>> : tc::constant<true> {};
+}
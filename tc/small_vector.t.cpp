@@ -0,0 +1,120 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "base/assert_defs.h"
+#include "unittest.h"
+#include "algorithm/append.h"
+#include "algorithm/equal.h"
+#include "algorithm/filter_inplace.h"
+#include "range/concat_adaptor.h"
+#include "range/iota_range.h"
+#include "small_vector.h"
+
+#include <stdexcept>
+
+UNITTESTDEF(small_vector_int) {
+	tc::small_vector<int, 4> vecn(tc::aggregate_tag, 1, 2, 3);
+	_ASSERT(vecn.is_inline());
+	_ASSERT(tc::equal(vecn, tc::iota(1, 4)));
+
+	tc::append(vecn, tc::iota(4, 100));
+	_ASSERT(!vecn.is_inline());
+	_ASSERT(tc::equal(vecn, tc::iota(1, 100)));
+
+	tc::filter_inplace(vecn, [](int const n) noexcept { return 0 == n % 10; });
+	_ASSERT(tc::equal(vecn, tc::vector<int>{10, 20, 30, 40, 50, 60, 70, 80, 90}));
+
+	// random-access chunks go through insert
+	tc::vector<int> const vecnMore{1, 2, 3};
+	tc::append(vecn, vecnMore);
+	vecn.insert(tc::begin(vecn), tc::begin(vecnMore), tc::end(vecnMore));
+	_ASSERTEQUAL(tc::size(vecn), 15);
+	_ASSERTEQUAL(vecn[0], 1);
+	_ASSERTEQUAL(vecn[3], 10);
+	_ASSERTEQUAL(vecn[14], 3);
+
+	tc::drop_first_inplace(vecn, 3);
+	tc::take_first_inplace(vecn, 2);
+	_ASSERT(tc::equal(vecn, tc::vector<int>{10, 20}));
+
+	// appending a vector to itself copies the elements before the old storage is freed
+	tc::small_vector<int, 2> vecnSelf;
+	tc::append(vecnSelf, tc::iota(0, 8));
+	_ASSERT(!vecnSelf.is_inline());
+	tc::append(vecnSelf, vecnSelf);
+	_ASSERT(tc::equal(vecnSelf, tc::concat(tc::iota(0, 8), tc::iota(0, 8))));
+	vecnSelf.insert(tc::begin(vecnSelf) + 1, tc::begin(vecnSelf), tc::end(vecnSelf));
+	_ASSERTEQUAL(tc::size(vecnSelf), 32);
+	_ASSERT(tc::equal(tc::make_iterator_range(tc::begin(vecnSelf), tc::begin(vecnSelf) + 18), tc::concat(tc::single(0), tc::iota(0, 8), tc::iota(0, 8), tc::single(1))));
+
+	auto vecnMoved = tc_move(vecn);
+	_ASSERT(tc::empty(vecn));
+	_ASSERT(vecn.is_inline());
+	_ASSERT(tc::equal(vecnMoved, tc::vector<int>{10, 20}));
+}
+
+UNITTESTDEF(small_vector_nontrivial) {
+	using vec_t = tc::small_vector<tc::string<char>, 2>;
+	vec_t vecstr(tc::aggregate_tag, "a", "b");
+	_ASSERT(vecstr.is_inline());
+
+	// emplace_back from an element that moves
+	tc::cont_emplace_back(vecstr, vecstr[0]);
+	_ASSERT(!vecstr.is_inline());
+	_ASSERT(tc::equal(vecstr, tc::vector<tc::string<char>>{"a", "b", "a"}));
+
+	vec_t vecstrInline(tc::aggregate_tag, "c");
+	vec_t vecstrCopy = vecstrInline;
+	vecstrCopy = vecstr;
+	_ASSERT(tc::equal(vecstrCopy, vecstr));
+	vecstrCopy = tc_move(vecstrInline);
+	_ASSERT(vecstrCopy.is_inline());
+	_ASSERT(tc::equal(vecstrCopy, tc::vector<tc::string<char>>{"c"}));
+
+	tc::filter_inplace(vecstr, [](tc::string<char> const& str) noexcept { return "a" == str; });
+	_ASSERT(tc::equal(vecstr, tc::vector<tc::string<char>>{"a", "a"}));
+	vecstr.resize(4);
+	_ASSERT(tc::empty(vecstr[3]));
+	vecstr.clear();
+	_ASSERT(tc::empty(vecstr));
+}
+
+namespace {
+	struct throwing_copy final {
+		explicit throwing_copy(int const n) noexcept : m_n(n) {}
+		throwing_copy(throwing_copy const& other) MAYTHROW : m_n(other.m_n) {
+			if( 3 == m_n ) throw std::runtime_error("copy");
+		}
+		throwing_copy(throwing_copy&&) noexcept = default;
+		throwing_copy& operator=(throwing_copy&&) noexcept = default;
+		int m_n;
+	};
+}
+
+UNITTESTDEF(small_vector_throwing_copy) {
+	// Copies that throw after spilling to the heap must not leak the buffer or the copied elements.
+	using vec_t = tc::small_vector<throwing_copy, 2>;
+	vec_t vec(tc::aggregate_tag, throwing_copy(1), throwing_copy(2));
+	tc::cont_emplace_back(vec, 3);
+	_ASSERT(!vec.is_inline());
+	bool bThrown = false;
+	try {
+		vec_t vecCopy = vec;
+	} catch( std::runtime_error const& ) {
+		bThrown = true;
+	}
+	_ASSERT(bThrown);
+
+	throwing_copy const tThrowing(3);
+	bThrown = false;
+	try {
+		vec_t vecAggregate(tc::aggregate_tag, throwing_copy(1), throwing_copy(2), tThrowing);
+	} catch( std::runtime_error const& ) {
+		bThrown = true;
+	}
+	_ASSERT(bThrown);
+}
@@ -11,9 +11,11 @@
 #include "../base/bitfield.h"
 #include "../base/rvalue_property.h"
 #include "../base/bit_cast.h"
+#include "../base/simd.h"
 #include "../algorithm/empty.h"
 #include "../algorithm/compare.h"
 #include "../range/range_adaptor.h"
+#include "../range/subrange.h"
 
 #include "value_restrictive.h"
 
@@ -402,6 +404,49 @@ namespace tc {
 			using base_::base_;
 		};
 
+		template<typename Rng>
+		concept bulk_transcodable = tc::contiguous_range<Rng const&>;
+
+		// Transcodes [pSrc, pSrcEnd) between UTF-8 and UTF-16 with the same results as iterating over SStringConversionRange<Dst, ...>,
+		// but converts runs of ASCII code units block by block. The output is passed to sink in chunks, i.e., sinks with chunk()
+		// receive contiguous ranges of Dst.
+		template<typename Dst, typename Src, typename Sink>
+		auto transcode_contiguous(Src const* pSrc, Src const* const pSrcEnd, Sink const& sink) MAYTHROW
+			-> tc::common_type_t<decltype(tc::for_each(tc::make_iterator_range(std::declval<Dst*>(), std::declval<Dst*>()), sink)), tc::constant<tc::continue_>>
+		{
+			static constexpr std::ptrdiff_t c_nBuffer = 1024;
+			static constexpr std::ptrdiff_t c_nMaxCodeUnitsPerCodePoint = tc::char_limits<Dst>::c_nMaxCodeUnitsPerCodePoint;
+			Dst aBuffer[c_nBuffer];
+			auto const rngSrc = tc::make_iterator_range(pSrc, pSrcEnd);
+			for(;;) {
+				Dst* pDst = aBuffer;
+				while( pSrc != pSrcEnd && c_nMaxCodeUnitsPerCodePoint <= aBuffer + c_nBuffer - pDst ) {
+					auto const pSrcAscii = tc::simd::convert_ascii_prefix(pSrc, pSrc + tc::min(pSrcEnd - pSrc, aBuffer + c_nBuffer - pDst), pDst);
+					pDst += pSrcAscii - pSrc;
+					pSrc = pSrcAscii;
+					if( pSrc == pSrcEnd || aBuffer + c_nBuffer - pDst < c_nMaxCodeUnitsPerCodePoint ) break;
+
+					// Single code point, or a tail of ASCII code units shorter than a block.
+					unsigned int const nCodePoint = [&]() noexcept {
+						if( auto const och = VERIFYNOTIFY(tc::codepoint_value_impl(rngSrc, pSrc)) ) {
+							return tc::to_underlying(*och);
+						} else {
+							return 0xfffdu; // REPLACEMENT CHARACTER
+						}
+					}();
+					VERIFYNOTIFYEQUAL(tc::codepoint_increment_index(rngSrc, pSrc), ecodeunitseqtypVALID);
+					for( int nCodeUnit = 0, nCodeUnits = tc::codepoint_codeunit_count<Dst>(nCodePoint); nCodeUnit < nCodeUnits; ++nCodeUnit ) {
+						*pDst = tc::codepoint_codeunit_at<Dst>(nCodePoint, nCodeUnit);
+						++pDst;
+					}
+				}
+				if( pSrc == pSrcEnd ) {
+					return tc::for_each(tc::make_iterator_range(aBuffer, pDst), sink); // MAYTHROW
+				}
+				tc_return_if_break(tc::for_each(tc::make_iterator_range(aBuffer, pDst), sink)) // MAYTHROW
+			}
+		}
+
 		template<typename Rng>
 		struct [[nodiscard]] SStringConversionRange<char, Rng, tc::char16> final
 			: SStringConversionRange<char, SStringConversionRange<char32_t, Rng>>
@@ -420,6 +465,11 @@ namespace tc {
 			{}
 			using typename base_::tc_index;
 
+			template<tc::decayed_derived_from<SStringConversionRange> Self, typename Sink> requires bulk_transcodable<std::remove_reference_t<Rng>>
+			friend auto for_each_impl(Self&& self, Sink const& sink) return_decltype_MAYTHROW(
+				convert_enc_impl::transcode_contiguous<char>(tc::ptr_begin(base_range_(self)), tc::ptr_end(base_range_(self)), sink)
+			)
+
 			constexpr auto border_base_index(tc_index const& idx) const& return_decltype_noexcept(
 				base_::base_range().border_base_index(base_::border_base_index(idx))
 			)
@@ -445,6 +495,11 @@ namespace tc {
 			{}
 			using typename base_::tc_index;
 
+			template<tc::decayed_derived_from<SStringConversionRange> Self, typename Sink> requires bulk_transcodable<std::remove_reference_t<Rng>>
+			friend auto for_each_impl(Self&& self, Sink const& sink) return_decltype_MAYTHROW(
+				convert_enc_impl::transcode_contiguous<tc::char16>(tc::ptr_begin(base_range_(self)), tc::ptr_end(base_range_(self)), sink)
+			)
+
 			constexpr auto border_base_index(tc_index const& idx) const& return_decltype_noexcept(
 				base_::base_range().border_base_index(base_::border_base_index(idx))
 			)
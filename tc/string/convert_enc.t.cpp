@@ -7,6 +7,9 @@
 // See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
 
 #include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "../algorithm/equal.h"
 #include "convert_enc.h"
 
 namespace {
@@ -49,3 +52,46 @@ static_assert(IsLeading(UTF16('\xD800')));
 static_assert(IsLeading(UTF16('\xDBFF')));
 static_assert(IsTrailing(UTF16('\xDC00')));
 static_assert(IsTrailing(UTF16('\xDFFF')));
+
+namespace {
+	// Iterates with the index interface, i.e., without the bulk transcoding of for_each.
+	template<typename Rng>
+	auto make_str_by_iterators(Rng const& rng) noexcept {
+		tc::string<tc::range_value_t<Rng const&>> str;
+		for( auto it = tc::begin(rng); it != tc::end(rng); ++it ) {
+			tc::cont_emplace_back(str, *it);
+		}
+		return str;
+	}
+}
+
+UNITTESTDEF(convert_enc_bulk) {
+	tc::string<char> str;
+	for( int n = 0; n < 3000; ++n ) {
+		tc::append(str, tc::string<char>(n % 23, 'a'));
+		switch( n % 5 ) {
+			case 0: tc::append(str, "\xc3\xa4"); break; // U+00E4
+			case 1: tc::append(str, "\xe2\x82\xac"); break; // U+20AC
+			case 2: tc::append(str, "\xf0\x9f\x98\x80"); break; // U+1F600
+			case 3: tc::append(str, "\x7f\x01"); break;
+			default: break;
+		}
+	}
+
+	auto const str16 = tc::make_str(tc::convert_enc<tc::char16>(str));
+	_ASSERT(tc::equal(str16, make_str_by_iterators(tc::convert_enc<tc::char16>(str))));
+	auto const str8 = tc::make_str(tc::convert_enc<char>(str16));
+	_ASSERT(tc::equal(str8, make_str_by_iterators(tc::convert_enc<char>(str16))));
+	_ASSERTEQUAL(str8, str);
+
+	for( auto const nSize : {0, 1, 15, 16, 17, 31, 32, 33, 1023, 1024, 1025} ) {
+		auto const strPrefix = tc::string<char>(nSize, 'x');
+		_ASSERT(tc::equal(tc::convert_enc<tc::char16>(strPrefix), make_str_by_iterators(tc::convert_enc<tc::char16>(strPrefix))));
+	}
+
+	int nCodeUnits = 0;
+	_ASSERTEQUAL(tc::break_, tc::for_each(tc::convert_enc<tc::char16>(str), [&](tc::char16) noexcept {
+		return tc::continue_if(2000 != ++nCodeUnits);
+	}));
+	_ASSERTEQUAL(nCodeUnits, 2000);
+}
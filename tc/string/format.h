@@ -16,6 +16,8 @@
 #include "../range/subrange.h"
 #include "../range/concat_adaptor.h"
 #include "../range/repeat_n.h"
+#include "../container/container.h"
+#include "../container/insert.h"
 #include "value_restrictive.h"
 
 // The following code disables warnings about the use of deprecated declarations when the code is compiled with Clang.
@@ -28,65 +30,122 @@
 #pragma clang diagnostic pop
 #endif
 
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
 namespace tc {
 	///////////////
 	// Wrapper to print integers as decimal
 
-    // Begin namespace `integral_as_padded_dec_adl`
-    // This namespace includes templates for padding decimal integers.
- 	namespace integral_as_padded_dec_adl {
-        // Template for a struct `integral_as_padded_dec_impl`, which prints integers as decimal.
-        // Uses template specialization to differentiate between base case and recursive case.
-		
-        // Recursive case
-        template< typename T, std::size_t N>
-		struct integral_as_padded_dec_impl;
-
-        // Base case
-		template< typename T>
-		struct integral_as_padded_dec_impl<T,1>;
-
-        // Recursive case is defined here.
-        // This struct is used to print an integer as a padded decimal by recursively calling itself.
+	namespace as_dec_detail {
+		// "00", "01", ..., "99"
+		inline constexpr auto c_achDigitPairs = []() noexcept {
+			std::array<tc::char_ascii, 200> ach{};
+			for( int n = 0; n < 100; ++n ) {
+				ach[2 * n] = tc::char_ascii(static_cast<char>('0' + n / 10));
+				ach[2 * n + 1] = tc::char_ascii(static_cast<char>('0' + n % 10));
+			}
+			return ach;
+		}();
+
+		// Writes the digits of n two at a time backwards from pchEnd and returns the first digit.
+		template<typename T>
+		[[nodiscard]] tc::char_ascii* write_dec_backwards(tc::char_ascii* pchEnd, T n) noexcept {
+			static_assert( std::is_unsigned<T>::value );
+			while( 100 <= n ) {
+				auto const nPair = static_cast<unsigned int>(n % 100);
+				n /= 100;
+				pchEnd -= 2;
+				pchEnd[0] = c_achDigitPairs[2 * nPair];
+				pchEnd[1] = c_achDigitPairs[2 * nPair + 1];
+			}
+			if( 10 <= n ) {
+				pchEnd -= 2;
+				pchEnd[0] = c_achDigitPairs[2 * n];
+				pchEnd[1] = c_achDigitPairs[2 * n + 1];
+			} else {
+				--pchEnd;
+				*pchEnd = tc::char_ascii(static_cast<char>('0' + n));
+			}
+			return pchEnd;
+		}
+
+		// The magnitude of n in an unsigned type of at least 32 bits, which is cheaper to divide than small types.
+		template<typename T>
+		[[nodiscard]] constexpr auto unsigned_abs(T const n) noexcept {
+			using unsigned_t = std::conditional_t<sizeof(T) <= sizeof(std::uint32_t), std::uint32_t, std::make_unsigned_t<T>>;
+			if constexpr( std::is_signed<T>::value ) {
+				return n < 0 ? static_cast<unsigned_t>(0u - static_cast<unsigned_t>(n)) : static_cast<unsigned_t>(n);
+			} else {
+				return static_cast<unsigned_t>(n);
+			}
+		}
+	}
+
+	namespace integral_as_padded_dec_adl {
+		// Prints m_n with at least N digits. The digits are formatted into a buffer on the stack, so sinks with chunk() receive
+		// the whole number at once.
 		template< typename T, std::size_t N>
-		struct [[nodiscard]] integral_as_padded_dec_impl : protected integral_as_padded_dec_impl<T,N-1> {
+		struct [[nodiscard]] integral_as_padded_dec_impl final {
 			friend auto range_output_t_impl(integral_as_padded_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
-			static constexpr unsigned long long c_nTenPow=integral_as_padded_dec_impl<T,N-1>::c_nTenPow*10;
-			constexpr integral_as_padded_dec_impl( T n ) noexcept : integral_as_padded_dec_impl<T,N-1>(n) {}
+			T m_n;
+			constexpr integral_as_padded_dec_impl( T n ) noexcept : m_n(n) {}
 
 			template<typename Sink>
-			auto operator()(Sink sink) const& MAYTHROW -> tc::common_type_t<
-				decltype(tc::continue_if_not_break(std::declval<Sink&>(), std::declval<tc::char_ascii>())),
-				decltype(std::declval<integral_as_padded_dec_impl<T,N-1> const&>()(std::declval<Sink>()))
-			> {
-				static_assert( std::is_unsigned<T>::value );
-				if( this->m_n<integral_as_padded_dec_impl::c_nTenPow ) {
-					tc_yield(sink, tc::char_ascii('0'));
+			auto operator()(Sink&& sink) const& MAYTHROW {
+				static_assert( 0<N );
+				static constexpr std::ptrdiff_t c_nBuffer = static_cast<std::ptrdiff_t>(std::max(N, static_cast<std::size_t>(std::numeric_limits<T>::digits10 + 1))) + 1/*sign*/;
+				tc::char_ascii ach[c_nBuffer];
+				auto pch = as_dec_detail::write_dec_backwards(ach + c_nBuffer, as_dec_detail::unsigned_abs(m_n));
+				while( ach + c_nBuffer - pch < static_cast<std::ptrdiff_t>(N) ) {
+					--pch;
+					*pch = tc::char_ascii('0');
+				}
+				if constexpr( std::is_signed<T>::value ) {
+					if( m_n < 0 ) {
+						--pch;
+						*pch = tc::char_ascii('-');
+					}
 				}
-				return tc::base_cast< integral_as_padded_dec_impl<T,N-1> >(*this)(tc_move(sink));
+				return tc::for_each(tc::make_iterator_range(tc::implicit_cast<tc::char_ascii const*>(pch), tc::implicit_cast<tc::char_ascii const*>(ach + c_nBuffer)), std::forward<Sink>(sink)); // MAYTHROW
 			}
 
 			constexpr bool empty() const& noexcept { return false; }
 		};
+	}
 
-        // Base case is defined here.
-        // The struct provides a definition for a wrapper to print a single-digit integer as a padded decimal.
- 		template< typename T>
-		struct [[nodiscard]] integral_as_padded_dec_impl<T,1> {
-			friend auto range_output_t_impl(integral_as_padded_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
-			T m_n;
-			static constexpr unsigned long long c_nTenPow=1;
-			constexpr integral_as_padded_dec_impl( T n ) noexcept : m_n(n) {}
+	namespace floating_point_as_dec_adl {
+		// Prints the shortest decimal representation which parses back to m_t, in fixed or scientific notation, whichever is shorter.
+		template< std::floating_point T >
+		struct [[nodiscard]] floating_point_as_dec_impl final {
+			friend auto range_output_t_impl(floating_point_as_dec_impl const&) -> tc::type::list<tc::char_ascii>; // declaration only
+			T m_t;
+			constexpr floating_point_as_dec_impl( T t ) noexcept : m_t(t) {}
 
 			template<typename Sink>
 			auto operator()(Sink&& sink) const& MAYTHROW {
-				return tc::for_each(tc::transform(tc::ptr_begin( boost::lexical_cast< std::array<char,50> >(m_n+0/*force integral promotion, otherwise unsigned/signed char gets printed as character*/) ), tc::fn_explicit_cast<tc::char_ascii>()), std::forward<Sink>(sink));
+				static_assert( std::is_trivially_copyable<tc::char_ascii>::value && 1 == sizeof(tc::char_ascii) );
+				static constexpr std::size_t c_nBuffer = 64;
+				tc::char_ascii ach[c_nBuffer];
+#ifdef __cpp_lib_to_chars
+				// The standard libraries implement the shortest round trip with Ryu.
+				char achChars[c_nBuffer];
+				auto const nLength = static_cast<std::size_t>(std::to_chars(achChars, achChars + c_nBuffer, m_t).ptr - achChars);
+#else
+				// Not necessarily the shortest representation, but it round trips, too.
+				auto const achChars = boost::lexical_cast<std::array<char, 50>>(m_t);
+				auto const nLength = std::strlen(tc::ptr_begin(achChars));
+#endif
+				std::memcpy(ach, tc::ptr_begin(achChars), nLength);
+				return tc::for_each(tc::make_iterator_range(tc::implicit_cast<tc::char_ascii const*>(ach), tc::implicit_cast<tc::char_ascii const*>(ach + nLength)), std::forward<Sink>(sink)); // MAYTHROW
 			}
 
 			constexpr bool empty() const& noexcept { return false; }
 		};
 	}
-    // End namespace `integral_as_padded_dec_adl`
 
     // as_dec is a function that takes an integer and returns a decimal representation of it.
 	template< tc::actual_integer T>
@@ -95,6 +154,12 @@ namespace tc {
 		(t)
 	)
 
+	template< std::floating_point T >
+	constexpr auto as_dec(T t) return_ctor_noexcept(
+		TC_FWD(floating_point_as_dec_adl::floating_point_as_dec_impl<T>),
+		(t)
+	)
+
 	template< typename T >
 	constexpr auto as_dec(tc::size_proxy<T> const& t) return_decltype_noexcept(
 		tc::as_dec(t.m_t)
@@ -171,17 +236,84 @@ namespace tc {
 		(t)
 	)
 
+	namespace from_string_detail {
+		// Contiguous ranges of 8 bit characters are parsed 8 digits at a time as one 64 bit integer (SWAR).
+		template<typename Rng>
+		concept swar_range =
+			std::endian::little == std::endian::native &&
+			tc::contiguous_range<Rng> &&
+			std::integral<tc::range_value_t<Rng>> && 1 == sizeof(tc::range_value_t<Rng>);
+
+		[[nodiscard]] inline std::uint64_t load_eight_chars(void const* const pv) noexcept {
+			std::uint64_t n;
+			std::memcpy(&n, pv, sizeof(n));
+			return n;
+		}
+
+		// Returns the number of leading digits of the 8 characters in n.
+		[[nodiscard]] inline int count_leading_digits(std::uint64_t const n) noexcept {
+			// A byte is a digit if its high nibble is 3, and adding 6 to it does not carry into the high nibble. Adding 6
+			// to a byte only carries into the next byte if the byte is no digit, so the first byte which is no digit is exact.
+			auto const nNonDigits = ((n & 0xf0f0f0f0f0f0f0f0) | (((n + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) ^ 0x3333333333333333;
+			return std::countr_zero(nNonDigits) / 8;
+		}
+
+		[[nodiscard]] constexpr std::uint32_t parse_eight_digits(std::uint64_t n) noexcept {
+			// Combines adjacent digits, then pairs of two and pairs of four digits with one multiplication each.
+			n = ((n & 0x0f0f0f0f0f0f0f0f) * 2561) >> 8;
+			n = ((n & 0x00ff00ff00ff00ff) * 6553601) >> 16;
+			return static_cast<std::uint32_t>(((n & 0x0000ffff0000ffff) * 42949672960001) >> 32);
+		}
+
+		inline constexpr std::array<std::uint32_t, 9> c_anPow10{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+		// Consumes the digits at p, up to 8 at a time without a branch per digit, as long as the value cannot exceed nMax.
+		template<std::uint64_t nMax, typename Char>
+		[[nodiscard]] std::uint64_t eight_digit_blocks(Char const*& p, Char const* const pEnd, std::uint64_t nValue) noexcept {
+			static_assert( 99999999 <= nMax );
+			while( 8 <= pEnd - p && nValue <= (nMax - 99999999) / 100000000 ) {
+				auto const n = load_eight_chars(p);
+				auto const nDigits = count_leading_digits(n);
+				if( 0 == nDigits ) break;
+				// Shifting the digits to the most significant bytes pads them with leading zeros.
+				nValue = nValue * c_anPow10[nDigits] + parse_eight_digits(n << (8 * (8 - nDigits)));
+				p += nDigits;
+				if( nDigits < 8 ) break;
+			}
+			return nValue;
+		}
+
+		// Parses the digits at it, which points into rng, up to 8 at a time as long as the value cannot exceed nMax, and advances it.
+		// The caller continues digit by digit.
+		template<std::uint64_t nMax, typename Rng, typename It>
+		[[nodiscard]] std::uint64_t eight_digit_blocks(Rng const& rng, It& it) noexcept {
+			tc::range_value_t<Rng> const* const pBegin = tc::ptr_begin(rng) + (it - tc::begin(rng));
+			auto p = pBegin;
+			auto const nValue = eight_digit_blocks<nMax>(p, tc::implicit_cast<tc::range_value_t<Rng> const*>(tc::ptr_end(rng)), 0);
+			it += p - pBegin;
+			return nValue;
+		}
+
+		template<typename T, typename Rng>
+		concept swar_integer = swar_range<Rng> && std::integral<T> && 99999999 <= std::numeric_limits<T>::max();
+	}
+
 	//////////////////////////////////////////////////
 	// conversion from string to number
 
-    // The following functions convert strings to numbers, checking for overflow or underflow and throwing exceptions when necessary.
+	// The following functions convert strings to numbers, checking for overflow or underflow and throwing exceptions when necessary.
+	// The head functions parse the longest prefix of rng whose value is representable in T, and return the value and the
+	// end of the prefix.
 	template< typename T, typename Rng >
 	auto unsigned_integer_from_string_head(Rng&& rng) noexcept {
 		auto pairnit=std::make_pair(tc::explicit_cast<T>(0),tc::begin(rng));
+		if constexpr( from_string_detail::swar_integer<T, Rng> ) {
+			pairnit.first=static_cast<T>(from_string_detail::eight_digit_blocks<static_cast<std::uint64_t>(std::numeric_limits<T>::max())>(rng, pairnit.second));
+		}
 		auto const itEnd=tc::end(rng);
 		while( pairnit.second!=itEnd ) {
 			unsigned int const nDigit=*pairnit.second-tc::explicit_cast<tc::range_value_t<Rng&>>('0');
-			if( 9<nDigit || (std::numeric_limits<T>::max()-static_cast<int>(nDigit))/10<pairnit.first ) break; // overflow
+			if( 9<nDigit || std::numeric_limits<T>::max()/10<pairnit.first || (std::numeric_limits<T>::max()/10==pairnit.first && static_cast<unsigned int>(std::numeric_limits<T>::max()%10)<nDigit) ) break; // overflow
 			pairnit.first*=10;
 MODIFY_WARNINGS_BEGIN(((disable)(4244))) // conversion from 'const unsigned int' to 'uint16_t', possible loss of data
 			pairnit.first+=nDigit;
@@ -198,9 +330,12 @@ MODIFY_WARNINGS_END
 		if( pairnit.second!=itEnd ) {
 			if (tc::explicit_cast<tc::range_value_t<Rng&>>('-') == *pairnit.second) {
 				++pairnit.second;
+				if constexpr( from_string_detail::swar_integer<T, Rng> ) {
+					pairnit.first = -static_cast<T>(from_string_detail::eight_digit_blocks<static_cast<std::uint64_t>(std::numeric_limits<T>::max())>(rng, pairnit.second));
+				}
 				while (pairnit.second != itEnd) {
 					unsigned int const nDigit = *pairnit.second - tc::explicit_cast<tc::range_value_t<Rng&>>('0');
-					if (9 < nDigit || pairnit.first < (std::numeric_limits<T>::lowest() + static_cast<int>(nDigit)) / 10) break; // underflow
+					if (9 < nDigit || pairnit.first < std::numeric_limits<T>::lowest() / 10 || (std::numeric_limits<T>::lowest() / 10 == pairnit.first && static_cast<unsigned int>(-(std::numeric_limits<T>::lowest() % 10)) < nDigit)) break; // underflow
 					pairnit.first *= 10;
 MODIFY_WARNINGS_BEGIN(((disable)(4244))) // conversion from 'const unsigned int' to 'uint16_t', possible loss of data
 					pairnit.first -= nDigit;
@@ -234,6 +369,141 @@ MODIFY_WARNINGS_END
 		return pairnit.first;
 	}
 
+	namespace from_string_detail {
+		[[nodiscard]] constexpr bool is_digit(char const ch) noexcept {
+			return static_cast<unsigned char>(ch - '0') < 10;
+		}
+
+		// Powers of ten, and integers up to c_nMaxExactMantissa, are exactly representable in T up to c_nMaxExactPow10.
+		template<typename T>
+		inline constexpr int c_nMaxExactPow10 = std::is_same<T, float>::value ? 10 : 22;
+		template<typename T>
+		inline constexpr std::uint64_t c_nMaxExactMantissa = std::uint64_t(1) << std::numeric_limits<T>::digits;
+		template<typename T>
+		inline constexpr auto c_atPow10 = []() noexcept {
+			std::array<T, c_nMaxExactPow10<T> + 1> at{};
+			T t = 1;
+			for( auto& tPow10 : at ) {
+				tPow10 = t;
+				t *= 10;
+			}
+			return at;
+		}();
+
+		// Parses [+-]digits[.digits][(e|E)[+-]digits], where either the integer or the fraction digits may be missing.
+		template<typename T>
+		[[nodiscard]] std::pair<T, char const*> float_from_chars_head(char const* const pBegin, char const* const pEnd) noexcept {
+			auto p = pBegin;
+			bool const bNegative = p != pEnd && '-' == *p;
+			if( p != pEnd && ('-' == *p || '+' == *p) ) ++p;
+			auto const pNumber = p;
+
+			// The up to 19 leading significant digits are nMantissa * 10^nExponent.
+			std::uint64_t nMantissa = 0;
+			int nExponent = 0;
+			bool bExact = true;
+			auto const ParseDigits = [&](bool const bFraction) noexcept {
+				auto const pDigits = p;
+				nMantissa = eight_digit_blocks<9999999999999999999u>(p, pEnd, nMantissa);
+				if( bFraction ) nExponent -= static_cast<int>(p - pDigits);
+				for( ; p != pEnd && is_digit(*p); ++p ) {
+					if( nMantissa < 1000000000000000000 ) {
+						nMantissa = nMantissa * 10 + static_cast<unsigned int>(*p - '0');
+						if( bFraction ) --nExponent;
+					} else {
+						if( !bFraction ) ++nExponent;
+						bExact = bExact && '0' == *p;
+					}
+				}
+				return pDigits != p;
+			};
+			bool bDigits = ParseDigits(/*bFraction*/false);
+			if( p != pEnd && '.' == *p ) {
+				auto const pDot = p;
+				++p;
+				if( !ParseDigits(/*bFraction*/true) && !bDigits ) p = pDot;
+				else bDigits = true;
+			}
+			if( !bDigits ) return std::make_pair(T(0), pBegin);
+
+			if( p != pEnd && ('e' == *p || 'E' == *p) ) {
+				auto pExponent = p + 1;
+				bool const bNegativeExponent = pExponent != pEnd && '-' == *pExponent;
+				if( pExponent != pEnd && ('-' == *pExponent || '+' == *pExponent) ) ++pExponent;
+				if( pExponent != pEnd && is_digit(*pExponent) ) {
+					int nExponentExplicit = 0;
+					for( ; pExponent != pEnd && is_digit(*pExponent); ++pExponent ) {
+						if( nExponentExplicit < 100000 ) nExponentExplicit = nExponentExplicit * 10 + (*pExponent - '0'); // saturate, the result is 0 or infinity anyway
+					}
+					nExponent += bNegativeExponent ? -nExponentExplicit : nExponentExplicit;
+					p = pExponent;
+				}
+			}
+
+			T t;
+			if( 0 == nMantissa ) {
+				t = 0;
+			} else if( bExact && nMantissa <= c_nMaxExactMantissa<T> && -c_nMaxExactPow10<T> <= nExponent && nExponent <= c_nMaxExactPow10<T> ) {
+				// Clinger's fast path: a single correctly rounded operation on exact operands.
+				t = static_cast<T>(nMantissa);
+				if( nExponent < 0 ) {
+					t /= c_atPow10<T>[-nExponent];
+				} else {
+					t *= c_atPow10<T>[nExponent];
+				}
+			} else {
+#ifdef __cpp_lib_to_chars
+				// The standard libraries implement std::from_chars with the Eisel-Lemire algorithm and fall back to big
+				// integer arithmetic only for the rare halfway cases.
+				auto const result = std::from_chars(pNumber, p, t, std::chars_format::general);
+				_ASSERTEQUAL(result.ptr, p);
+				if( std::errc::result_out_of_range == result.ec ) {
+					int nExponentLeading = nExponent;
+					for( auto n = nMantissa; 10 <= n; n /= 10 ) ++nExponentLeading;
+					t = 0 <= nExponentLeading ? std::numeric_limits<T>::infinity() : T(0);
+				}
+#else
+				VERIFY(boost::conversion::try_lexical_convert(pNumber, p - pNumber, t));
+#endif
+			}
+			return std::make_pair(bNegative ? -t : t, p);
+		}
+	}
+
+	template< std::floating_point T, typename Rng >
+	auto float_from_string_head(Rng&& rng) noexcept {
+		auto pairtit=std::make_pair(T(0), tc::begin(rng));
+		if constexpr( from_string_detail::swar_range<Rng> ) {
+			auto const pBegin=reinterpret_cast<char const*>(tc::ptr_begin(rng));
+			auto const pairtp=from_string_detail::float_from_chars_head<T>(pBegin, pBegin + tc::size_raw(rng));
+			pairtit.first=pairtp.first;
+			pairtit.second+=pairtp.second - pBegin;
+		} else {
+			// Copy the characters which may be part of the number.
+			tc::vector<char> vecch;
+			for( auto it=pairtit.second; it!=tc::end(rng); ++it ) {
+				auto const n=static_cast<unsigned int>(*it);
+				if( !(('0'<=n && n<='9') || '+'==n || '-'==n || '.'==n || 'e'==n || 'E'==n) ) break;
+				tc::cont_emplace_back(vecch, static_cast<char>(n));
+			}
+			auto const pairtp=from_string_detail::float_from_chars_head<T>(vecch.data(), vecch.data() + vecch.size());
+			pairtit.first=pairtp.first;
+			for( auto n=pairtp.second - vecch.data(); 0<n; --n ) ++pairtit.second;
+		}
+		return pairtit;
+	}
+
+	struct float_parse_exception final {};
+
+	// Correctly rounded, locale independent conversion of decimal floating point numbers.
+	template< std::floating_point T, typename Rng >
+	T float_from_string( Rng const& rng ) THROW(tc::float_parse_exception) {
+		if (tc::empty(rng)) throw tc::float_parse_exception();
+		auto pairtit=tc::float_from_string_head<T>(rng);
+		if( pairtit.second!=tc::end(rng) ) throw tc::float_parse_exception();
+		return pairtit.first;
+	}
+
 	namespace no_adl {
 		template<typename Rng>
 		struct [[nodiscard]] size_prefixed_impl : private tc::range_adaptor_base_range<Rng> {
@@ -0,0 +1,188 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/transform.h"
+#include "../algorithm/append.h"
+#include "format.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+	template<typename T, typename Rng>
+	void check_integer_head(Rng const& rng, T const nExpected, std::ptrdiff_t const nLength) noexcept {
+		auto const pairnit = std::is_signed<T>::value ? tc::signed_integer_from_string_head<T>(rng) : tc::unsigned_integer_from_string_head<T>(rng);
+		_ASSERTEQUAL(pairnit.first, nExpected);
+		_ASSERTEQUAL(pairnit.second - tc::begin(rng), nLength);
+	}
+
+	template<typename T>
+	void check_integer_head(char const* const sz, T const nExpected, std::ptrdiff_t const nLength) noexcept {
+		tc::string<char> const str(sz);
+		check_integer_head<T>(str, nExpected, nLength);
+		tc::string<tc::char16> const str16(str.begin(), str.end()); // no SWAR
+		check_integer_head<T>(str16, nExpected, nLength);
+	}
+}
+
+UNITTESTDEF(integer_from_string_head) {
+	check_integer_head<std::uint64_t>("18446744073709551615", std::numeric_limits<std::uint64_t>::max(), 20);
+	check_integer_head<std::uint64_t>("18446744073709551616", 1844674407370955161, 19); // stops before the overflowing digit
+	check_integer_head<std::uint64_t>("000000000000000000000000000000042x", 42, 33);
+	check_integer_head<std::uint32_t>("4294967295", std::numeric_limits<std::uint32_t>::max(), 10);
+	check_integer_head<std::uint32_t>("4294967296", 429496729, 9);
+	check_integer_head<std::uint32_t>("1234567a90", 1234567, 7);
+	check_integer_head<std::uint8_t>("256", 25, 2);
+	check_integer_head<std::int64_t>("-9223372036854775808", std::numeric_limits<std::int64_t>::lowest(), 20);
+	check_integer_head<std::int64_t>("-9223372036854775809", -922337203685477580, 19);
+	check_integer_head<std::int64_t>("9223372036854775807", std::numeric_limits<std::int64_t>::max(), 19);
+	check_integer_head<std::int64_t>("+9223372036854775808", 922337203685477580, 19);
+	check_integer_head<std::int32_t>("-2147483648", std::numeric_limits<std::int32_t>::lowest(), 11);
+	check_integer_head<std::int32_t>("-12345678,", -12345678, 9);
+	check_integer_head<std::int8_t>("-129", -12, 3);
+	check_integer_head<int>("", 0, 0);
+	check_integer_head<int>("-", 0, 1);
+
+	_ASSERTEQUAL(tc::unsigned_integer_from_string<unsigned int>(tc::string<char>("1234567890")), 1234567890u);
+	_ASSERTEQUAL(tc::signed_integer_from_string<int>(tc::string<char>("-1234567890")), -1234567890);
+	try {
+		static_cast<void>(tc::signed_integer_from_string<int>(tc::string<char>("12345678901")));
+		_ASSERTFALSE;
+	} catch( tc::integer_parse_exception const& ) {}
+}
+
+namespace {
+	template<typename T>
+	void check_float(char const* const sz, std::ptrdiff_t const nLength) noexcept {
+		tc::string<char> const str(sz);
+		auto const pairtit = tc::float_from_string_head<T>(str);
+		_ASSERTEQUAL(pairtit.second - tc::begin(str), nLength);
+		T tExpected = 0;
+		if( 0 < nLength ) {
+			auto const itBegin = tc::begin(str) + ('+' == str[0] ? 1 : 0);
+			auto const result = std::from_chars(std::to_address(itBegin), str.data() + nLength, tExpected);
+			_ASSERT(std::errc() == result.ec || std::errc::result_out_of_range == result.ec);
+			if( std::errc::result_out_of_range == result.ec ) {
+				tExpected = std::strtod(str.c_str(), nullptr) == 0 ? T(0) : std::numeric_limits<T>::infinity(); // compare magnitude only
+				_ASSERTEQUAL(std::abs(pairtit.first), tExpected);
+				return;
+			}
+		}
+		_ASSERT(std::signbit(tExpected) == std::signbit(pairtit.first));
+		_ASSERTEQUAL(pairtit.first, tExpected);
+
+		auto const pairtit16 = tc::float_from_string_head<T>(tc::transform(str, [](char const ch) noexcept { return tc::char16(ch); }));
+		_ASSERTEQUAL(pairtit16.first, pairtit.first);
+	}
+}
+
+UNITTESTDEF(float_from_string_head) {
+	check_float<double>("0", 1);
+	check_float<double>("-0.0", 4);
+	check_float<double>("1.5e3x", 5);
+	check_float<double>("1e", 1);
+	check_float<double>("1e+", 1);
+	check_float<double>(".5", 2);
+	check_float<double>("5.", 2);
+	check_float<double>(".", 0);
+	check_float<double>("-.e1", 0);
+	check_float<double>("+2.25", 5);
+	check_float<double>("1.7976931348623157e308", 22);
+	check_float<double>("1.8e308", 7);
+	check_float<double>("4.9e-324", 8);
+	check_float<double>("1e-400", 6);
+	check_float<double>("0.1000000000000000055511151231257827021181583404541015625", 57); // exactly the double nearest to 0.1
+	check_float<double>("9007199254740993", 16); // halfway between two doubles
+	check_float<double>("123456789012345678901234567890e-10", 34);
+	check_float<double>("0.000000000000000000000000000000000000000000001e45", 50);
+	check_float<float>("3.4028235e38", 12);
+	check_float<float>("1.17549435e-38", 14);
+	check_float<float>("16777217", 8);
+
+	unsigned int nState = 4711;
+	auto const Random = [&](unsigned int const nMax) noexcept {
+		nState = nState * 1103515245u + 12345u;
+		return (nState >> 8) % nMax;
+	};
+	for( int n = 0; n < 10000; ++n ) {
+		char ach[64];
+		auto const nDigits = 1 + Random(20);
+		tc::string<char> strDigits;
+		for( unsigned int nDigit = 0; nDigit < nDigits; ++nDigit ) strDigits.push_back(static_cast<char>('0' + Random(10)));
+		auto const nPoint = Random(nDigits + 1);
+		std::snprintf(ach, sizeof(ach), "%s%.*s.%se%d", 0 == Random(2) ? "-" : "", static_cast<int>(nPoint), strDigits.c_str(), strDigits.c_str() + nPoint, static_cast<int>(Random(80)) - 40);
+		check_float<double>(ach, static_cast<std::ptrdiff_t>(std::strlen(ach)));
+		check_float<float>(ach, static_cast<std::ptrdiff_t>(std::strlen(ach)));
+	}
+
+	_ASSERTEQUAL(tc::float_from_string<double>(tc::string<char>("-12.5")), -12.5);
+	try {
+		static_cast<void>(tc::float_from_string<double>(tc::string<char>("1.5.")));
+		_ASSERTFALSE;
+	} catch( tc::float_parse_exception const& ) {}
+}
+
+namespace {
+	struct chunk_counter final {
+		tc::string<char>* m_pstr;
+		int* m_pnChunks;
+
+		void operator()(char const ch) const& noexcept {
+			tc::cont_emplace_back(*m_pstr, ch);
+		}
+
+		template<typename Rng>
+		void chunk(Rng const& rng) const& noexcept {
+			++*m_pnChunks;
+			tc::append(*m_pstr, rng);
+		}
+	};
+
+	template<typename Rng>
+	tc::string<char> format_as_single_chunk(Rng const& rng) noexcept {
+		tc::string<char> str;
+		int nChunks = 0;
+		tc::for_each(rng, chunk_counter{&str, &nChunks});
+		_ASSERTEQUAL(nChunks, 1);
+		return str;
+	}
+}
+
+UNITTESTDEF(as_dec) {
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(0)), "0");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(7)), "7");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(-10)), "-10");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<signed char>::min())), "-128");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<unsigned char>::max())), "255");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<int>::min())), "-2147483648");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<long long>::min())), "-9223372036854775808");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<unsigned long long>::max())), "18446744073709551615");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_padded_dec<4>(42)), "0042");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_padded_dec<2>(12345)), "12345");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_padded_dec<25>(std::numeric_limits<std::uint64_t>::max())), "0000018446744073709551615");
+	_ASSERTEQUAL(tc::make_str<char>(tc::as_dec(-5), ",", tc::as_padded_dec<3>(5)), "-5,005");
+
+	for( long long n = 1; n < std::numeric_limits<long long>::max() / 3; n = n * 3 + 1 ) {
+		char ach[32];
+		_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(-n)), tc::string<char>(ach, std::to_chars(ach, ach + sizeof(ach), -n).ptr));
+		_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(n)), tc::string<char>(ach, std::to_chars(ach, ach + sizeof(ach), n).ptr));
+	}
+
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(0.1)), "0.1");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(-2.5f)), "-2.5");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(1e100)), "1e+100");
+	_ASSERTEQUAL(format_as_single_chunk(tc::as_dec(std::numeric_limits<double>::denorm_min())), "5e-324");
+	unsigned int nState = 4711;
+	for( int n = 0; n < 10000; ++n ) {
+		nState = nState * 1103515245u + 12345u;
+		auto const d = std::ldexp(static_cast<double>(nState), static_cast<int>(nState % 200) - 100);
+		_ASSERTEQUAL(tc::float_from_string<double>(tc::make_str<char>(tc::as_dec(d))), d);
+	}
+}
@@ -11,8 +11,27 @@
 #include "../base/assert_defs.h"
 #include "../base/generic_macros.h"
 #include "../algorithm/append.h"
+#include "small_string.h"
 
 namespace tc {
+	namespace make_c_str_detail {
+		// Enough for most paths and messages without allocating.
+		template< typename Char >
+		using c_str_buffer = tc::small_string<Char, 255>;
+
+		template< typename Char, typename... Rng >
+		c_str_buffer<Char> make_c_str_buffer(Rng&& ... rng) MAYTHROW {
+			c_str_buffer<Char> str;
+			if constexpr( (tc::has_size<Rng> && ...) && (std::is_same<tc::range_value_t<Rng&>, Char>::value && ...) ) {
+				// Concatenations of Char that do not fit allocate exactly once. When transcoding, the sizes count the code units of
+				// the source encoding, so they are no estimate of the result size.
+				tc::cont_reserve(str, (tc::size(rng) + ...));
+			}
+			tc::append(str, std::forward<Rng>(rng)...); // MAYTHROW
+			return str;
+		}
+	}
+
 	namespace no_adl {
 		template< typename Char, typename Rng, typename Enable = void >
 		struct has_convertible_as_c_str final
@@ -50,7 +69,7 @@ namespace tc {
 	//  make_c_str(<Char>): create a value or reference holder which is castable to c string
 
 	//   1. One input range, tc::as_c_str(rng) is valid and convertible to Char const*: hold the value or reference of the rng, castable to tc::as_c_str(rng)
-	//   2. Otherwise: create and hold a tc::string<Char>, castable to Char const*
+	//   2. Otherwise: create and hold a tc::small_string<Char, 255>, castable to Char const*. Only longer strings allocate.
 	//   3. Explicitly specified <Char> could be omitted if the char pointer type deduced from the first rng is convertible to destination c string
 	//   4. make_mutable_c_str(<Char>): create a value or reference holder which is castable to mutable c string
 
@@ -68,7 +87,7 @@ namespace tc {
 	template< typename Char, typename Rng0, typename... Rng >
 	auto make_c_str(Rng0&& rng0, Rng&& ... rng) MAYTHROW {
 		static_assert(tc::decayed<Char>);
-		return tc::no_adl::make_c_str_impl<Char const, tc::string<Char>>(tc::make_str<Char>(std::forward<Rng0>(rng0), std::forward<Rng>(rng)...));
+		return tc::no_adl::make_c_str_impl<Char const, make_c_str_detail::c_str_buffer<Char>>(make_c_str_detail::make_c_str_buffer<Char>(std::forward<Rng0>(rng0), std::forward<Rng>(rng)...));
 	}
 
 	template< typename Rng0, typename... Rng >
@@ -90,7 +109,7 @@ namespace tc {
 	template< typename Char, typename Rng0, typename... Rng >
 	auto make_mutable_c_str(Rng0&& rng0, Rng&& ... rng) MAYTHROW {
 		static_assert(tc::decayed<Char>);
-		return tc::no_adl::make_c_str_impl<Char, tc::string<Char>>(tc::make_str<Char>(std::forward<Rng0>(rng0), std::forward<Rng>(rng)...));
+		return tc::no_adl::make_c_str_impl<Char, make_c_str_detail::c_str_buffer<Char>>(make_c_str_detail::make_c_str_buffer<Char>(std::forward<Rng0>(rng0), std::forward<Rng>(rng)...));
 	}
 
 	template< typename Rng0, typename... Rng >
@@ -0,0 +1,249 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/reference_or_value.h"
+#include "../range/meta.h"
+#include "../range/range_adaptor.h"
+#include "../range/subrange.h"
+#include "../algorithm/algorithm.h"
+#include "../container/container.h"
+#include "../tuple.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace tc {
+	namespace multi_search_detail {
+		using state_type = std::uint32_t;
+
+		// Characters not occurring in any pattern share class 0, so the transition table has one column per distinct
+		// pattern character plus one.
+		template<typename Char>
+		struct char_classes final {
+			template<typename RngRng>
+			explicit char_classes(RngRng const& rngrngPattern) MAYTHROW {
+				tc::for_each(rngrngPattern, [&](auto const& rngPattern) MAYTHROW {
+					tc::for_each(rngPattern, [&](Char const ch) MAYTHROW { tc::cont_emplace_back(m_vecch, ch); }); // MAYTHROW
+				}); // MAYTHROW
+				tc::sort_unique_inplace(m_vecch);
+			}
+
+			[[nodiscard]] std::size_t count() const& noexcept { return m_vecch.size() + 1; }
+			[[nodiscard]] state_type operator()(Char const ch) const& noexcept {
+				auto const it = tc::iterator::lower_bound(tc::begin(m_vecch), tc::end(m_vecch), ch, tc::fn_less());
+				return tc::end(m_vecch) == it || ch != *it ? 0 : static_cast<state_type>(it - tc::begin(m_vecch) + 1);
+			}
+
+		private:
+			tc::vector<Char> m_vecch; // sorted
+		};
+
+		template<typename Char> requires (1 == sizeof(Char))
+		struct char_classes<Char> final {
+			template<typename RngRng>
+			explicit char_classes(RngRng const& rngrngPattern) noexcept {
+				m_anClass.fill(0);
+				tc::for_each(rngrngPattern, [&](auto const& rngPattern) noexcept {
+					tc::for_each(rngPattern, [&](Char const ch) noexcept { m_anClass[static_cast<unsigned char>(ch)] = 1; });
+				});
+				for( auto& nClass : m_anClass ) {
+					if( 0 != nClass ) nClass = static_cast<std::uint16_t>(++m_nCount - 1);
+				}
+			}
+
+			[[nodiscard]] std::size_t count() const& noexcept { return m_nCount; }
+			[[nodiscard]] state_type operator()(Char const ch) const& noexcept { return m_anClass[static_cast<unsigned char>(ch)]; }
+
+		private:
+			std::array<std::uint16_t, 256> m_anClass;
+			std::size_t m_nCount = 1;
+		};
+	}
+
+	namespace no_adl {
+		// Aho-Corasick automaton which finds all occurrences of a set of patterns in a single pass over the text.
+		// The failure links are resolved at construction, so the automaton is a DFA stored as one flat transition table
+		// with a row per state and a column per character class. Each character costs two table lookups. A state_type is the
+		// offset of the row of the state.
+		template<typename Char>
+		struct aho_corasick final {
+			using state_type = multi_search_detail::state_type;
+
+			template<typename RngRng>
+			explicit aho_corasick(RngRng const& rngrngPattern) MAYTHROW
+				: m_charclasses(rngrngPattern) // MAYTHROW
+			{
+				auto const nClasses = m_charclasses.count();
+				// While building, states are numbered consecutively and the start state, which is never a target in the trie,
+				// marks missing transitions.
+				static constexpr state_type c_nNoState = 0;
+				tc::vector<tc::vector<std::size_t>> vecvecnOutput;
+				auto const AddState = [&]() MAYTHROW {
+					m_vecnTransition.resize(m_vecnTransition.size() + nClasses, c_nNoState); // MAYTHROW
+					tc::cont_emplace_back(vecvecnOutput); // MAYTHROW
+					return static_cast<state_type>(vecvecnOutput.size() - 1);
+				};
+				AddState(); // MAYTHROW
+
+				// trie
+				tc::for_each(rngrngPattern, [&](auto const& rngPattern) MAYTHROW {
+					_ASSERT(!tc::empty(rngPattern)); // an empty pattern would match everywhere
+					state_type nState = c_nStart;
+					std::size_t nSize = 0;
+					tc::for_each(rngPattern, [&](Char const ch) MAYTHROW {
+						auto const nIndex = nState * nClasses + m_charclasses(ch);
+						if( c_nNoState == m_vecnTransition[nIndex] ) {
+							auto const nStateNew = AddState(); // MAYTHROW
+							m_vecnTransition[nIndex] = nStateNew;
+						}
+						nState = m_vecnTransition[nIndex];
+						++nSize;
+					}); // MAYTHROW
+					tc::cont_emplace_back(vecvecnOutput[nState], m_vecnPatternSize.size()); // MAYTHROW
+					tc::cont_emplace_back(m_vecnPatternSize, nSize); // MAYTHROW
+				}); // MAYTHROW
+
+				// Breadth-first, the failure state of each state is shallower and thus complete before the state itself.
+				tc::vector<state_type> vecnFailure(vecvecnOutput.size(), c_nStart); // MAYTHROW
+				tc::vector<state_type> vecnQueue;
+				tc::cont_reserve(vecnQueue, vecvecnOutput.size()); // MAYTHROW
+				for( std::size_t nClass = 0; nClass < nClasses; ++nClass ) {
+					if( auto const nStateNext = m_vecnTransition[nClass] ) tc::cont_emplace_back(vecnQueue, nStateNext);
+				}
+				for( std::size_t nQueue = 0; nQueue < vecnQueue.size(); ++nQueue ) {
+					auto const nState = vecnQueue[nQueue];
+					auto const nFailure = vecnFailure[nState];
+					tc::append(vecvecnOutput[nState], vecvecnOutput[nFailure]); // MAYTHROW
+					for( std::size_t nClass = 0; nClass < nClasses; ++nClass ) {
+						auto& nStateNext = m_vecnTransition[nState * nClasses + nClass];
+						if( c_nNoState == nStateNext ) {
+							nStateNext = m_vecnTransition[nFailure * nClasses + nClass];
+						} else {
+							vecnFailure[nStateNext] = m_vecnTransition[nFailure * nClasses + nClass];
+							tc::cont_emplace_back(vecnQueue, nStateNext);
+						}
+					}
+				}
+
+				// Renumber the states such that states without matches come first and store each state as the offset of its row.
+				// Then next needs no multiplication and has_matches a single comparison.
+				_ASSERT(vecvecnOutput.size() * nClasses <= std::numeric_limits<state_type>::max());
+				tc::vector<state_type> vecnRow(vecvecnOutput.size()); // MAYTHROW
+				state_type nRow = 0;
+				for( bool const bMatches : {false, true} ) {
+					if( bMatches ) m_nFirstMatchingRow = nRow;
+					for( std::size_t nState = 0; nState < vecvecnOutput.size(); ++nState ) {
+						if( bMatches != tc::empty(vecvecnOutput[nState]) ) {
+							vecnRow[nState] = nRow;
+							nRow += static_cast<state_type>(nClasses);
+							if( bMatches ) {
+								tc::cont_emplace_back(m_vecnOutputBegin, m_vecnOutput.size()); // MAYTHROW
+								tc::append(m_vecnOutput, vecvecnOutput[nState]); // MAYTHROW
+							}
+						}
+					}
+				}
+				tc::cont_emplace_back(m_vecnOutputBegin, m_vecnOutput.size()); // MAYTHROW
+				_ASSERTEQUAL(vecnRow[c_nStart], c_nStart); // no empty patterns
+
+				tc::vector<state_type> vecnTransition(m_vecnTransition.size()); // MAYTHROW
+				for( std::size_t nState = 0; nState < vecvecnOutput.size(); ++nState ) {
+					for( std::size_t nClass = 0; nClass < nClasses; ++nClass ) {
+						vecnTransition[vecnRow[nState] + nClass] = vecnRow[m_vecnTransition[nState * nClasses + nClass]];
+					}
+				}
+				m_vecnTransition = tc_move(vecnTransition);
+			}
+
+			static constexpr state_type c_nStart = 0;
+
+			[[nodiscard]] state_type next(state_type const nState, Char const ch) const& noexcept {
+				return m_vecnTransition[nState + m_charclasses(ch)];
+			}
+
+			[[nodiscard]] bool has_matches(state_type const nState) const& noexcept {
+				return m_nFirstMatchingRow <= nState;
+			}
+
+			// Indices of the patterns ending in nState, longest first. Of equal patterns, the earliest comes first.
+			[[nodiscard]] auto matches(state_type const nState) const& noexcept {
+				_ASSERTDEBUG(has_matches(nState));
+				auto const nIndex = (nState - m_nFirstMatchingRow) / m_charclasses.count();
+				return tc::slice(m_vecnOutput, tc::begin(m_vecnOutput) + m_vecnOutputBegin[nIndex], tc::begin(m_vecnOutput) + m_vecnOutputBegin[nIndex + 1]);
+			}
+
+			[[nodiscard]] std::size_t pattern_count() const& noexcept { return m_vecnPatternSize.size(); }
+			[[nodiscard]] std::size_t pattern_size(std::size_t const nPattern) const& noexcept { return m_vecnPatternSize[nPattern]; }
+
+		private:
+			multi_search_detail::char_classes<Char> m_charclasses;
+			tc::vector<state_type> m_vecnTransition; // indexed by row offset of the state plus character class
+			state_type m_nFirstMatchingRow;
+			tc::vector<std::size_t> m_vecnOutputBegin; // indexed by the number of the state among the states with matches
+			tc::vector<std::size_t> m_vecnOutput;
+			tc::vector<std::size_t> m_vecnPatternSize;
+		};
+	}
+	using no_adl::aho_corasick;
+
+	template<typename RngRng>
+	[[nodiscard]] auto make_aho_corasick(RngRng const& rngrngPattern) MAYTHROW {
+		return tc::aho_corasick<tc::range_value_t<tc::range_value_t<RngRng const&>>>(rngrngPattern); // MAYTHROW
+	}
+
+	namespace multi_search_adaptor_adl {
+		template<typename Rng, typename AhoCorasick>
+		struct [[nodiscard]] multi_search_adaptor : tc::range_adaptor_base_range<Rng> {
+		private:
+			using base_ = typename multi_search_adaptor::range_adaptor_base_range;
+			reference_or_value<AhoCorasick> m_ahocorasick;
+
+			template<typename Self>
+			using match_t = tc::tuple<std::size_t, decltype(tc::slice(std::declval<Self&>().base_range(), tc::begin(std::declval<Self&>().base_range()), tc::begin(std::declval<Self&>().base_range())))>;
+
+		public:
+			template<typename RngRef, typename AhoCorasickRef>
+			constexpr multi_search_adaptor(RngRef&& rng, AhoCorasickRef&& ahocorasick) noexcept
+				: base_(tc::aggregate_tag, std::forward<RngRef>(rng))
+				, m_ahocorasick(tc::aggregate_tag, std::forward<AhoCorasickRef>(ahocorasick))
+			{}
+
+			template<typename Self, std::enable_if_t<tc::decayed_derived_from<Self, multi_search_adaptor>>* = nullptr> // use terse syntax when Xcode supports https://cplusplus.github.io/CWG/issues/2369.html
+			friend auto range_output_t_impl(Self&&) -> tc::type::list<match_t<Self>> {} // unevaluated
+
+			template<tc::decayed_derived_from<multi_search_adaptor> Self, typename Sink>
+			friend auto for_each_impl(Self&& self, Sink sink) MAYTHROW -> tc::common_type_t<decltype(tc::continue_if_not_break(sink, std::declval<match_t<Self>>())), tc::constant<tc::continue_>> {
+				auto const& ahocorasick = *self.m_ahocorasick;
+				auto&& rng = self.base_range();
+				auto state = ahocorasick.c_nStart;
+				auto const itEnd = tc::end(rng);
+				for( auto it = tc::begin(rng); itEnd != it; ) {
+					state = ahocorasick.next(state, *it);
+					++it;
+					if( ahocorasick.has_matches(state) ) {
+						for( auto const nPattern : ahocorasick.matches(state) ) {
+							tc_yield(sink, tc::make_tuple(nPattern, tc::slice(rng, it - ahocorasick.pattern_size(nPattern), it)));
+						}
+					}
+				}
+				return tc::constant<tc::continue_>();
+			}
+		};
+	}
+
+	// Generates the occurrences of the patterns of ahocorasick in rngWhere as tuples of the pattern index and the subrange of
+	// rngWhere, ordered by their end. Occurrences may overlap.
+	template<typename Rng, typename AhoCorasick> requires std::random_access_iterator<tc::iterator_t<Rng>>
+	auto multi_search(Rng&& rngWhere, AhoCorasick&& ahocorasick) return_ctor_noexcept(
+		TC_FWD(multi_search_adaptor_adl::multi_search_adaptor<Rng, AhoCorasick>),
+		(std::forward<Rng>(rngWhere), std::forward<AhoCorasick>(ahocorasick))
+	)
+}
@@ -0,0 +1,82 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "multi_search.h"
+#include "spirit_algorithm.h"
+
+namespace {
+	// Finds the matches with tc::search_first from every position and sorts them like tc::multi_search.
+	template<typename Char>
+	auto naive_multi_search(tc::vector<Char> const& vecchWhere, tc::vector<tc::vector<Char>> const& vecvecchPattern) noexcept {
+		tc::vector<std::tuple<std::size_t, std::size_t, std::size_t>> vectplnMatch; // end, begin, pattern
+		for( std::size_t nBegin = 0; nBegin < vecchWhere.size(); ++nBegin ) {
+			for( std::size_t nPattern = 0; nPattern < vecvecchPattern.size(); ++nPattern ) {
+				if( tc::starts_with<tc::return_bool>(tc::begin_next<tc::return_drop>(vecchWhere, nBegin), vecvecchPattern[nPattern]) ) {
+					tc::cont_emplace_back(vectplnMatch, std::make_tuple(nBegin + vecvecchPattern[nPattern].size(), nBegin, nPattern));
+				}
+			}
+		}
+		tc::sort_inplace(vectplnMatch);
+		return vectplnMatch;
+	}
+
+	template<typename Char>
+	void check_multi_search_random(int const nAlphabet) noexcept {
+		unsigned int nState = 4711;
+		auto const Random = [&](unsigned int const nMax) noexcept {
+			nState = nState * 1103515245u + 12345u;
+			return (nState >> 8) % nMax;
+		};
+		for( int nRound = 0; nRound < 200; ++nRound ) {
+			tc::vector<Char> vecchWhere;
+			for( auto n = Random(200); 0 < n; --n ) tc::cont_emplace_back(vecchWhere, static_cast<Char>('a' + Random(nAlphabet + 1)));
+			tc::vector<tc::vector<Char>> vecvecchPattern;
+			for( auto nPattern = 1 + Random(10); 0 < nPattern; --nPattern ) {
+				tc::vector<Char> vecchPattern;
+				for( auto n = 1 + Random(6); 0 < n; --n ) tc::cont_emplace_back(vecchPattern, static_cast<Char>('a' + Random(nAlphabet)));
+				tc::cont_emplace_back(vecvecchPattern, tc_move(vecchPattern));
+			}
+
+			auto const ahocorasick = tc::make_aho_corasick(vecvecchPattern);
+			_ASSERTEQUAL(ahocorasick.pattern_count(), vecvecchPattern.size());
+			tc::vector<std::tuple<std::size_t, std::size_t, std::size_t>> vectplnMatch;
+			tc::for_each(tc::multi_search(vecchWhere, ahocorasick), [&](auto const& tplnrngMatch) noexcept {
+				auto const& [nPattern, rngMatch] = tplnrngMatch;
+				_ASSERT(tc::equal(rngMatch, vecvecchPattern[nPattern]));
+				tc::cont_emplace_back(vectplnMatch, std::make_tuple(
+					static_cast<std::size_t>(tc::end(rngMatch) - tc::begin(vecchWhere)),
+					static_cast<std::size_t>(tc::begin(rngMatch) - tc::begin(vecchWhere)),
+					nPattern
+				));
+			});
+			_ASSERT(tc::is_sorted(vectplnMatch, [](auto const& lhs, auto const& rhs) noexcept { return std::get<0>(lhs) < std::get<0>(rhs); }));
+			tc::sort_inplace(vectplnMatch);
+			_ASSERT(tc::equal(vectplnMatch, naive_multi_search(vecchWhere, vecvecchPattern)));
+		}
+	}
+}
+
+UNITTESTDEF(multi_search) {
+	for( int nAlphabet = 1; nAlphabet <= 4; ++nAlphabet ) {
+		check_multi_search_random<char>(nAlphabet);
+		check_multi_search_random<char16_t>(nAlphabet);
+	}
+
+	auto const ahocorasick = tc::make_aho_corasick(tc::vector<tc::string<char>>{"he", "she", "his", "hers", "she"});
+	tc::vector<std::pair<std::size_t, tc::string<char>>> vecpairnstr;
+	tc::for_each(tc::multi_search(tc::string<char>("ushers"), ahocorasick), [&](auto const& tplnrngMatch) noexcept {
+		tc::cont_emplace_back(vecpairnstr, tc::get<0>(tplnrngMatch), tc::make_str(tc::get<1>(tplnrngMatch)));
+	});
+	_ASSERT(tc::equal(vecpairnstr, tc::vector<std::pair<std::size_t, tc::string<char>>>{{1, "she"}, {4, "she"}, {0, "he"}, {3, "hers"}}));
+
+	// the generator stops when the sink breaks
+	int nMatches = 0;
+	_ASSERTEQUAL(tc::for_each(tc::multi_search(tc::string<char>("ushers"), ahocorasick), [&](tc::unused) noexcept { return ++nMatches < 2 ? tc::continue_ : tc::break_; }), tc::break_);
+	_ASSERTEQUAL(nMatches, 2);
+}
@@ -0,0 +1,195 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/simd.h"
+#include "../range/meta.h"
+#include "../container/container.h"
+#include "../algorithm/size.h"
+#include "../algorithm/minmax.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace tc {
+	namespace searcher_detail {
+		// Needles up to this length are searched with a SIMD filter on their first and last element, longer ones with Two-Way.
+		inline constexpr std::size_t c_nShortNeedle = 32;
+
+		template<typename Char>
+		[[nodiscard]] inline bool equal_n(Char const* const pLhs, Char const* const pRhs, std::size_t const n) noexcept {
+			return 0 == std::memcmp(pLhs, pRhs, n * sizeof(Char));
+		}
+
+		// The shift table is indexed by the low byte of each element. Elements sharing a byte share the smallest shift.
+		template<typename Char>
+		[[nodiscard]] inline std::uint8_t shift_index(Char const ch) noexcept {
+			return static_cast<std::uint8_t>(tc::simd::to_uint(ch));
+		}
+
+		// Returns the start and the period of the maximal suffix of [pch, pch+n) with respect to the order of the elements
+		// as unsigned integers or, if bReversed, the reverse order (Crochemore-Perrin).
+		template<typename Char>
+		[[nodiscard]] std::pair<std::size_t, std::size_t> maximal_suffix(Char const* const pch, std::size_t const n, bool const bReversed) noexcept {
+			std::size_t nBeforeSuffix = static_cast<std::size_t>(-1); // unsigned arithmetic wraps around
+			std::size_t j = 0;
+			std::size_t k = 1;
+			std::size_t nPeriod = 1;
+			while( j + k < n ) {
+				auto const nSuffix = tc::simd::to_uint(pch[nBeforeSuffix + k]);
+				auto const nCandidate = tc::simd::to_uint(pch[j + k]);
+				if( nSuffix == nCandidate ) {
+					if( k == nPeriod ) {
+						j += nPeriod;
+						k = 1;
+					} else {
+						++k;
+					}
+				} else if( (nCandidate < nSuffix) != bReversed ) {
+					j += k;
+					k = 1;
+					nPeriod = j - nBeforeSuffix;
+				} else {
+					nBeforeSuffix = j++;
+					k = nPeriod = 1;
+				}
+			}
+			return std::make_pair(nBeforeSuffix + 1, nPeriod);
+		}
+	}
+
+	namespace no_adl {
+		// Preprocessed needle for repeated searches with tc::search_first. Searching is linear in the length of the haystack:
+		// - Short needles on SSE2/AVX2 are located by comparing a block of candidate positions with the first and the last
+		//   element of the needle at once. Only positions matching both are compared in full.
+		// - Long needles use the Two-Way algorithm, which skips ahead by the last element of each window as in Boyer-Moore-Horspool.
+		template<tc::simd::bitwise_comparable Char>
+		struct searcher final {
+			template<typename Rng>
+			explicit searcher(Rng const& rngWhat) MAYTHROW
+				: m_vecchNeedle(tc::explicit_cast<tc::vector<Char>>(rngWhat)) // MAYTHROW
+			{
+				auto const nLength = m_vecchNeedle.size();
+				auto const pchNeedle = m_vecchNeedle.data();
+
+				m_anShift.fill(nLength);
+				for( std::size_t i = 0; i < nLength; ++i ) {
+					m_anShift[searcher_detail::shift_index(pchNeedle[i])] = nLength - 1 - i;
+				}
+
+				// Critical factorization: the later of the maximal suffixes with respect to both orders.
+				auto const pairnn = searcher_detail::maximal_suffix(pchNeedle, nLength, /*bReversed*/false);
+				auto const pairnnReversed = searcher_detail::maximal_suffix(pchNeedle, nLength, /*bReversed*/true);
+				std::tie(m_nCritical, m_nPeriod) = pairnn.first < pairnnReversed.first ? pairnnReversed : pairnn;
+
+				if( m_nCritical + m_nPeriod <= nLength && searcher_detail::equal_n(pchNeedle, pchNeedle + m_nPeriod, m_nCritical) ) {
+					// The needle is periodic: after a mismatch in the left half, the shifted window already matches the first
+					// nLength-m_nPeriod elements.
+					m_nMemory = nLength - m_nPeriod;
+				} else {
+					m_nPeriod = tc::max(m_nCritical, nLength - m_nCritical) + 1;
+					m_nMemory = 0;
+				}
+			}
+
+			[[nodiscard]] tc::vector<Char> const& needle() const& noexcept { return m_vecchNeedle; }
+
+			// Returns the beginning of the first occurrence of the needle in [pBegin, pEnd) or nullptr.
+			[[nodiscard]] Char const* find_first(Char const* pBegin, Char const* const pEnd) const& noexcept {
+				auto const nLength = m_vecchNeedle.size();
+				if( static_cast<std::size_t>(pEnd - pBegin) < nLength ) return nullptr;
+				switch( nLength ) {
+					case 0: return pBegin;
+					case 1: {
+						auto const pchFound = tc::simd::find_first_equal(pBegin, pEnd, m_vecchNeedle[0]);
+						return pEnd == pchFound ? nullptr : pchFound;
+					}
+					default:
+#ifdef TC_SIMD_SSE2
+						if( nLength <= searcher_detail::c_nShortNeedle ) return find_first_short(pBegin, pEnd);
+#endif
+						return find_first_two_way(pBegin, pEnd);
+				}
+			}
+
+		private:
+#ifdef TC_SIMD_SSE2
+			[[nodiscard]] Char const* find_first_short(Char const* pBegin, Char const* const pEnd) const& noexcept {
+				static constexpr std::ptrdiff_t c_nPerBlock = tc::simd::c_nBlockSize / sizeof(Char);
+				static constexpr std::uint32_t c_nLaneMask = (std::uint32_t(1) << sizeof(Char)) - 1;
+				auto const nLength = m_vecchNeedle.size();
+				auto const pchNeedle = m_vecchNeedle.data();
+				auto const blkFirst = tc::simd::broadcast(pchNeedle[0]);
+				auto const blkLast = tc::simd::broadcast(pchNeedle[nLength - 1]);
+				for( ; c_nPerBlock + static_cast<std::ptrdiff_t>(nLength) - 1 <= pEnd - pBegin; pBegin += c_nPerBlock ) {
+					auto nMask = tc::simd::byte_mask(tc::simd::bit_and(
+						tc::simd::equal<sizeof(Char)>(tc::simd::load(pBegin), blkFirst),
+						tc::simd::equal<sizeof(Char)>(tc::simd::load(pBegin + nLength - 1), blkLast)
+					));
+					while( 0 != nMask ) {
+						auto const nLane = static_cast<std::size_t>(std::countr_zero(nMask)) / sizeof(Char);
+						if( searcher_detail::equal_n(pBegin + nLane + 1, pchNeedle + 1, nLength - 2) ) return pBegin + nLane;
+						nMask &= ~(c_nLaneMask << (nLane * sizeof(Char)));
+					}
+				}
+				for( ; static_cast<std::ptrdiff_t>(nLength) <= pEnd - pBegin; ++pBegin ) {
+					if( searcher_detail::equal_n(pBegin, pchNeedle, nLength) ) return pBegin;
+				}
+				return nullptr;
+			}
+#endif
+
+			[[nodiscard]] Char const* find_first_two_way(Char const* pBegin, Char const* const pEnd) const& noexcept {
+				auto const nLength = m_vecchNeedle.size();
+				auto const pchNeedle = m_vecchNeedle.data();
+				std::size_t nMemory = 0; // length of the prefix of the window known to match
+				while( nLength <= static_cast<std::size_t>(pEnd - pBegin) ) {
+					if( auto nShift = m_anShift[searcher_detail::shift_index(pBegin[nLength - 1])] ) {
+						if( 0 != nMemory && nShift < m_nPeriod ) {
+							// The last period of the window has an element out of place, so there can be no match before it.
+							nShift = nLength - m_nPeriod;
+						}
+						pBegin += nShift;
+						nMemory = 0;
+						continue;
+					}
+
+					auto i = tc::max(m_nCritical, nMemory);
+					while( i < nLength && pchNeedle[i] == pBegin[i] ) ++i;
+					if( i < nLength ) {
+						pBegin += i - m_nCritical + 1;
+						nMemory = 0;
+						continue;
+					}
+
+					i = m_nCritical;
+					while( nMemory < i && pchNeedle[i - 1] == pBegin[i - 1] ) --i;
+					if( i <= nMemory ) return pBegin;
+					pBegin += m_nPeriod;
+					nMemory = m_nMemory;
+				}
+				return nullptr;
+			}
+
+			tc::vector<Char> m_vecchNeedle;
+			std::array<std::size_t, 256> m_anShift; // distance of the last occurrence from the end of the needle
+			std::size_t m_nCritical; // start of the right half of the critical factorization
+			std::size_t m_nPeriod; // shift after a match of the right half
+			std::size_t m_nMemory; // nonzero if the needle is periodic
+		};
+	}
+	using no_adl::searcher;
+
+	template<typename Rng>
+	[[nodiscard]] tc::searcher<tc::range_value_t<Rng const&>> make_searcher(Rng const& rngWhat) MAYTHROW {
+		return tc::searcher<tc::range_value_t<Rng const&>>(rngWhat); // MAYTHROW
+	}
+}
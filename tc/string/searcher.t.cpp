@@ -0,0 +1,76 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../range/transform.h"
+#include "spirit_algorithm.h"
+
+namespace {
+	template<typename Char>
+	void check_searcher(tc::vector<Char> const& vecchWhere, tc::vector<Char> const& vecchWhat) noexcept {
+		auto const searcher = tc::make_searcher(vecchWhat);
+		auto const orngFound = tc::search_first<tc::return_view_or_none>(vecchWhere, searcher);
+		auto const orngExpected = tc::search_first<tc::return_view_or_none>(vecchWhere, vecchWhat);
+		_ASSERTEQUAL(tc::explicit_cast<bool>(orngFound), tc::explicit_cast<bool>(orngExpected));
+		if( orngFound ) {
+			_ASSERT(tc::begin(*orngExpected) == tc::begin(*orngFound));
+			_ASSERT(tc::end(*orngExpected) == tc::end(*orngFound));
+		}
+	}
+
+	// Small alphabets produce many partial and periodic matches.
+	template<typename Char>
+	void check_searcher_random(int const nAlphabet, std::size_t const nMaxNeedle) noexcept {
+		unsigned int nState = 4711;
+		auto const Random = [&](unsigned int const nMax) noexcept {
+			nState = nState * 1103515245u + 12345u;
+			return (nState >> 8) % nMax;
+		};
+		for( int nRound = 0; nRound < 300; ++nRound ) {
+			tc::vector<Char> vecchWhere;
+			for( auto n = Random(300); 0 < n; --n ) tc::cont_emplace_back(vecchWhere, static_cast<Char>('a' + Random(nAlphabet)));
+			tc::vector<Char> vecchWhat;
+			if( !tc::empty(vecchWhere) && 0 == Random(2) ) {
+				// take the needle from the haystack so that it occurs at least once
+				auto const nBegin = Random(tc::size(vecchWhere));
+				auto const nEnd = tc::min(tc::size(vecchWhere), nBegin + 1 + Random(nMaxNeedle));
+				vecchWhat = tc::explicit_cast<tc::vector<Char>>(tc::slice(vecchWhere, tc::begin(vecchWhere) + nBegin, tc::begin(vecchWhere) + nEnd));
+			} else {
+				for( auto n = 1 + Random(nMaxNeedle); 0 < n; --n ) tc::cont_emplace_back(vecchWhat, static_cast<Char>('a' + Random(nAlphabet)));
+			}
+			check_searcher(vecchWhere, vecchWhat);
+		}
+	}
+}
+
+UNITTESTDEF(searcher) {
+	for( int nAlphabet = 1; nAlphabet <= 4; ++nAlphabet ) {
+		check_searcher_random<char>(nAlphabet, 8);
+		check_searcher_random<char>(nAlphabet, 80);
+		check_searcher_random<char16_t>(nAlphabet, 80);
+		check_searcher_random<int>(nAlphabet, 80);
+	}
+
+	// periodic needle longer than the short needle limit
+	tc::string<char> const strWhat(40, 'a');
+	auto const searcher = tc::make_searcher(strWhat);
+	auto const strWhere = tc::string<char>(100, 'a') + "b" + tc::string<char>(39, 'a');
+	auto const rngFound = tc::search_first<tc::return_view>(strWhere, searcher);
+	_ASSERT(tc::begin(strWhere) == tc::begin(rngFound));
+	_ASSERTEQUAL(tc::size(rngFound), 40);
+	_ASSERT(tc::search_first<tc::return_bool>(tc::begin_next<tc::return_drop>(strWhere, 60), searcher));
+	_ASSERT(!tc::search_first<tc::return_bool>(tc::begin_next<tc::return_drop>(strWhere, 61), searcher));
+	_ASSERTEQUAL(tc::search_first<tc::return_begin_index>(tc::begin_next<tc::return_drop>(strWhere, 62), tc::make_searcher("ba")), 38);
+
+	// non-contiguous ranges are searched with the needle
+	_ASSERT(tc::search_first<tc::return_bool>(tc::transform(strWhere, [](char const ch) noexcept { return ch; }), tc::make_searcher("ab")));
+	_ASSERT(!tc::search_first<tc::return_bool>(tc::transform(strWhere, [](char const ch) noexcept { return ch; }), tc::make_searcher("bb")));
+
+	_ASSERT(tc::search_first<tc::return_bool>(tc::string<char>(), tc::make_searcher("")));
+	_ASSERT(!tc::search_first<tc::return_bool>(tc::string<char>("a"), tc::make_searcher("aa")));
+}
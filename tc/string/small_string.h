@@ -0,0 +1,202 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "../base/assert_defs.h"
+#include "../base/type_traits_fwd.h"
+#include "../algorithm/minmax.h"
+
+#include <cstring>
+#include <utility>
+
+namespace tc {
+	namespace no_adl {
+		// Zero-terminated string which keeps up to N characters inline and only allocates if it grows larger. Provides
+		// reserve() and insert(), so tc::append reserves once and copies random-access chunks in one go.
+		template<tc::char_type Char, std::size_t N>
+		struct small_string final {
+			static_assert( 0 < N );
+
+			using value_type = Char;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = Char&;
+			using const_reference = Char const&;
+			using iterator = Char*;
+			using const_iterator = Char const*;
+
+			small_string() noexcept {
+				m_achInline[0] = Char();
+			}
+
+			small_string(Char const* const pch, std::size_t const n) MAYTHROW : small_string() {
+				append(pch, n); // MAYTHROW
+			}
+
+			small_string(small_string const& str) MAYTHROW : small_string(str.data(), str.size()) {}
+
+			small_string(small_string&& str) noexcept {
+				steal(str);
+			}
+
+			small_string& operator=(small_string const& str) & MAYTHROW {
+				if( this != std::addressof(str) ) {
+					clear();
+					append(str.data(), str.size()); // MAYTHROW
+				}
+				return *this;
+			}
+
+			small_string& operator=(small_string&& str) & noexcept {
+				if( this != std::addressof(str) ) {
+					free();
+					steal(str);
+				}
+				return *this;
+			}
+
+			~small_string() {
+				free();
+			}
+
+			[[nodiscard]] Char* begin() & noexcept { return m_pch; }
+			[[nodiscard]] Char const* begin() const& noexcept { return m_pch; }
+			[[nodiscard]] Char* end() & noexcept { return m_pch + m_n; }
+			[[nodiscard]] Char const* end() const& noexcept { return m_pch + m_n; }
+			[[nodiscard]] Char* data() & noexcept { return m_pch; }
+			[[nodiscard]] Char const* data() const& noexcept { return m_pch; }
+			[[nodiscard]] Char const* c_str() const& noexcept { return m_pch; }
+
+			[[nodiscard]] std::size_t size() const& noexcept { return m_n; }
+			[[nodiscard]] bool empty() const& noexcept { return 0 == m_n; }
+			[[nodiscard]] std::size_t capacity() const& noexcept { return m_nCapacity; }
+			[[nodiscard]] bool is_inline() const& noexcept { return m_achInline == m_pch; }
+
+			[[nodiscard]] Char& operator[](std::size_t const i) & noexcept {
+				_ASSERTDEBUG(i < m_n);
+				return m_pch[i];
+			}
+
+			[[nodiscard]] Char const& operator[](std::size_t const i) const& noexcept {
+				_ASSERTDEBUG(i < m_n);
+				return m_pch[i];
+			}
+
+			void reserve(std::size_t const n) & MAYTHROW {
+				if( m_nCapacity < n ) {
+					auto const pch = new Char[n + 1]; // MAYTHROW
+					std::memcpy(pch, m_pch, (m_n + 1) * sizeof(Char));
+					free();
+					m_pch = pch;
+					m_nCapacity = n;
+				}
+			}
+
+			void push_back(Char const ch) & MAYTHROW {
+				if( m_n == m_nCapacity ) reserve(m_nCapacity * 2); // MAYTHROW
+				m_pch[m_n] = ch;
+				m_pch[++m_n] = Char();
+			}
+
+			Char& emplace_back(Char const ch) & MAYTHROW {
+				push_back(ch); // MAYTHROW
+				return m_pch[m_n - 1];
+			}
+
+			void pop_back() & noexcept {
+				_ASSERTDEBUG(0 < m_n);
+				m_pch[--m_n] = Char();
+			}
+
+			// [itBegin, itEnd) may refer to this string if it lies before itPos, e.g., in tc::append(str, str).
+			template<typename It>
+			Char* insert(Char const* const itPos, It itBegin, It const itEnd) & MAYTHROW {
+				_ASSERTDEBUG(m_pch <= itPos && itPos <= end());
+				auto const nPos = static_cast<std::size_t>(itPos - m_pch);
+				auto const n = static_cast<std::size_t>(itEnd - itBegin);
+				if( m_nCapacity - m_n < n ) {
+					// The inserted characters are copied before the old buffer is freed.
+					auto const nCapacity = tc::max(m_n + n, m_nCapacity * 2);
+					auto const pch = new Char[nCapacity + 1]; // MAYTHROW
+					std::memcpy(pch, m_pch, nPos * sizeof(Char));
+					copy_to(pch + nPos, itBegin, itEnd);
+					std::memcpy(pch + nPos + n, m_pch + nPos, (m_n - nPos + 1) * sizeof(Char));
+					free();
+					m_pch = pch;
+					m_nCapacity = nCapacity;
+				} else {
+					std::memmove(m_pch + nPos + n, m_pch + nPos, (m_n - nPos + 1) * sizeof(Char));
+					copy_to(m_pch + nPos, itBegin, itEnd);
+				}
+				m_n += n;
+				return m_pch + nPos;
+			}
+
+			void append(Char const* const pch, std::size_t const n) & MAYTHROW {
+				insert(end(), pch, pch + n); // MAYTHROW
+			}
+
+			void take_inplace(Char const* const it) & noexcept {
+				_ASSERTDEBUG(m_pch <= it && it <= end());
+				m_n = static_cast<std::size_t>(it - m_pch);
+				m_pch[m_n] = Char();
+			}
+
+			void clear() & noexcept {
+				take_inplace(m_pch);
+			}
+
+		private:
+			template<typename It>
+			static void copy_to(Char* pch, It itBegin, It const itEnd) noexcept {
+				for( ; itBegin != itEnd; ++itBegin, ++pch ) {
+					*pch = *itBegin;
+				}
+			}
+
+			void free() & noexcept {
+				if( !is_inline() ) delete[] m_pch;
+			}
+
+			void steal(small_string& str) & noexcept {
+				if( str.is_inline() ) {
+					std::memcpy(m_achInline, str.m_achInline, (str.m_n + 1) * sizeof(Char));
+					m_pch = m_achInline;
+					m_n = str.m_n;
+					m_nCapacity = N;
+				} else {
+					m_pch = std::exchange(str.m_pch, str.m_achInline);
+					m_n = std::exchange(str.m_n, 0);
+					m_nCapacity = std::exchange(str.m_nCapacity, N);
+					str.m_achInline[0] = Char();
+				}
+			}
+
+			Char* m_pch = m_achInline;
+			std::size_t m_n = 0;
+			std::size_t m_nCapacity = N;
+			Char m_achInline[N + 1];
+		};
+	}
+	using no_adl::small_string;
+
+	template<typename Char, std::size_t N>
+	[[nodiscard]] Char const* as_c_str(tc::small_string<Char, N> const& str) noexcept {
+		return str.data();
+	}
+
+	template<typename Char, std::size_t N>
+	[[nodiscard]] Char* as_c_str(tc::small_string<Char, N>& str) noexcept {
+		return str.data();
+	}
+
+	template<typename Char, std::size_t N>
+	[[nodiscard]] Char* as_c_str(tc::small_string<Char, N>&& str) noexcept {
+		return str.data();
+	}
+}
@@ -0,0 +1,78 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#include "../base/assert_defs.h"
+#include "../unittest.h"
+#include "../algorithm/append.h"
+#include "../algorithm/equal.h"
+#include "convert_enc.h"
+#include "format.h"
+#include "make_c_str.h"
+#include "small_string.h"
+
+UNITTESTDEF(small_string) {
+	tc::small_string<char, 8> str;
+	_ASSERT(tc::empty(str));
+	_ASSERTEQUAL(*tc::as_c_str(str), '\0');
+
+	tc::append(str, "abc", tc::as_dec(42));
+	_ASSERT(str.is_inline());
+	_ASSERT(tc::equal(str, "abc42"));
+	_ASSERT(tc::equal(tc::as_c_str(str), "abc42"));
+
+	// spills to the heap and keeps the contents
+	tc::append(str, tc::string<char>("defghijk"));
+	_ASSERT(!str.is_inline());
+	_ASSERT(tc::equal(tc::as_c_str(str), "abc42defghijk"));
+
+	tc::take_first_inplace(str, 3);
+	_ASSERT(tc::equal(tc::as_c_str(str), "abc"));
+	str.insert(tc::begin(str) + 1, "xy", "xy" + 2);
+	_ASSERT(tc::equal(tc::as_c_str(str), "axybc"));
+
+	auto strCopy = str;
+	auto const strMoved = tc_move(str);
+	_ASSERT(tc::empty(str));
+	_ASSERT(str.is_inline());
+	_ASSERT(tc::equal(strMoved, strCopy));
+	str = strMoved;
+	_ASSERT(tc::equal(str, "axybc"));
+	tc::span<char const> const spanch = str;
+	_ASSERT(tc::ptr_begin(spanch) == tc::as_c_str(str));
+
+	// appending a string to itself reads the characters before the old buffer is freed
+	tc::small_string<char, 8> strSelf(tc::as_c_str("abcdef"), 6);
+	tc::append(strSelf, strSelf);
+	_ASSERT(tc::equal(tc::as_c_str(strSelf), "abcdefabcdef"));
+	tc::append(strSelf, strSelf);
+	_ASSERT(tc::equal(tc::as_c_str(strSelf), "abcdefabcdefabcdefabcdef"));
+
+	tc::small_string<char, 8> strInline(tc::as_c_str("inline"), 6);
+	strCopy = tc_move(strInline);
+	_ASSERT(tc::equal(strCopy, "inline"));
+
+	// convert_enc goes through the appender
+	tc::small_string<char, 8> strUtf8;
+	tc::append(strUtf8, u"\u00e4\u00f6\u00fc\u00df!");
+	_ASSERT(tc::equal(tc::as_c_str(strUtf8), "\u00e4\u00f6\u00fc\u00df!"));
+	tc::small_string<char16_t, 4> strUtf16;
+	tc::append(strUtf16, tc::convert_enc<char16_t>(tc::as_c_str(strUtf8)));
+	_ASSERT(tc::equal(strUtf16, u"\u00e4\u00f6\u00fc\u00df!"));
+}
+
+UNITTESTDEF(make_c_str_small_string) {
+	auto const strShort = tc::make_c_str("C:\\Temp\\", tc::string<char>("file"), ".txt");
+	_ASSERT(tc::equal(tc::implicit_cast<char const*>(strShort), "C:\\Temp\\file.txt"));
+
+	tc::string<char> const strLong(1000, 'x');
+	auto const strLongCStr = tc::make_c_str("a", strLong, tc::as_dec(7));
+	_ASSERTEQUAL(std::strlen(tc::implicit_cast<char const*>(strLongCStr)), 1002);
+
+	auto strMutable = tc::make_mutable_c_str<char16_t>(u"ab", u"cd");
+	tc::implicit_cast<char16_t*>(strMutable)[0] = u'x';
+	_ASSERT(tc::equal(tc::implicit_cast<char16_t const*>(strMutable), u"xbcd"));
+}
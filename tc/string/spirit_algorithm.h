@@ -12,6 +12,7 @@
 #include "../range/meta.h"
 #include "../algorithm/algorithm.h"
 #include "spirit.h"
+#include "searcher.h"
 
 namespace tc {
 	template<typename RangeReturn, typename Rng, tc::derived_from<x3::parser_base> Expr>
@@ -57,6 +58,22 @@ namespace tc {
 		return tc::search_first<RangeReturn>(std::forward<RngWhere>(rngWhere), rngWhat, tc::fn_equal_to_or_parse_match());
 	}
 
+	template<typename RangeReturn, typename RngWhere, typename Char>
+	[[nodiscard]] decltype(auto) search_first(RngWhere&& rngWhere, tc::searcher<Char> const& searcher) noexcept {
+		if constexpr( tc::contiguous_range<RngWhere> && std::is_same<tc::range_value_t<RngWhere>, Char>::value ) {
+			auto const pBegin = tc::ptr_begin(rngWhere);
+			if( auto const pFound = searcher.find_first(pBegin, tc::ptr_end(rngWhere)) ) {
+				auto itBegin = tc::begin(rngWhere) + (pFound - pBegin);
+				auto itEnd = itBegin + tc::size(searcher.needle());
+				return RangeReturn::pack_view(std::forward<RngWhere>(rngWhere), tc_move(itBegin), tc_move(itEnd));
+			} else {
+				return RangeReturn::pack_no_element(std::forward<RngWhere>(rngWhere));
+			}
+		} else {
+			return tc::search_first<RangeReturn>(std::forward<RngWhere>(rngWhere), searcher.needle());
+		}
+	}
+
 	template<typename RangeReturn, typename Rng, tc::derived_from<x3::parser_base> Expr>
 	decltype(auto) search_first(Rng&& rng, Expr const& expr) noexcept {
 		auto const itEnd = tc::end(rng);
@@ -0,0 +1,269 @@
+// think-cell public library
+//
+// Copyright (C) 2016-2023 think-cell Software GmbH
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
+
+#pragma once
+
+#include "base/assert_defs.h"
+#include "base/noncopyable.h"
+#include "base/scope.h"
+#include "base/modified.h"
+#include "algorithm/minmax.h"
+#include "container/container.h" // tc::vector
+#include "container/cont_reserve.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+
+namespace tc {
+	namespace thread_pool_detail {
+		struct batch_access;
+
+		struct batch_base : tc::nonmovable {
+			// Executes task nTask of the batch and marks it as finished. Exceptions are stored and rethrown by the thread waiting for the batch.
+			void execute(std::size_t const nTask) & noexcept {
+				try {
+					run(nTask); // MAYTHROW
+				} catch (...) {
+					std::scoped_lock lock(m_mtx);
+					if( !m_pexception || nTask < m_nTaskException ) { // report the exception that a sequential loop would have reported
+						m_pexception = std::current_exception();
+						m_nTaskException = nTask;
+					}
+				}
+				std::scoped_lock lock(m_mtx);
+				_ASSERT(0 < m_nPending);
+				if( 0 == --m_nPending ) {
+					m_cv.notify_all(); // notify under lock: the waiting thread destroys the batch as soon as it can acquire m_mtx
+				}
+			}
+
+		protected:
+			explicit batch_base(std::size_t const nTasks) noexcept : m_nPending(nTasks) {}
+			~batch_base() = default;
+			virtual void run(std::size_t nTask) & MAYTHROW = 0;
+
+		private:
+			friend struct tc::thread_pool_detail::batch_access;
+			std::mutex m_mtx;
+			std::condition_variable m_cv;
+			std::size_t m_nPending;
+			std::exception_ptr m_pexception;
+			std::size_t m_nTaskException = 0;
+		};
+
+		struct batch_access final {
+			static void wait(batch_base& batch) MAYTHROW {
+				std::unique_lock lock(batch.m_mtx);
+				batch.m_cv.wait(lock, [&]() noexcept { return 0 == batch.m_nPending; });
+				if( batch.m_pexception ) {
+					std::rethrow_exception(batch.m_pexception); // THROW
+				}
+			}
+
+			static bool done(batch_base& batch) noexcept {
+				std::scoped_lock lock(batch.m_mtx);
+				return 0 == batch.m_nPending;
+			}
+		};
+
+		template<typename Func>
+		struct batch final : batch_base {
+			batch(std::size_t const nTasks, Func& func) noexcept : batch_base(nTasks), m_func(func) {}
+		private:
+			void run(std::size_t const nTask) & MAYTHROW override {
+				m_func(nTask); // MAYTHROW
+			}
+			Func& m_func;
+		};
+
+		struct task final {
+			batch_base* m_pbatch;
+			std::size_t m_nTask;
+		};
+	}
+
+	namespace no_adl {
+		// Work-stealing thread pool: every worker thread owns a task queue, pops tasks from its back and, when it runs dry,
+		// steals from the front of the queues of the other workers. Threads waiting for their tasks to complete help executing
+		// queued tasks, so nested parallel algorithms do not deadlock.
+		struct thread_pool final : tc::nonmovable {
+			explicit thread_pool(std::size_t const nThreads = tc::max(std::thread::hardware_concurrency(), 1u)) MAYTHROW
+				: m_vecqueue(nThreads)
+			{
+				_ASSERT(0 < nThreads);
+				tc::cont_reserve(m_vecthread, nThreads);
+				try {
+					for( std::size_t nThread = 0; nThread < nThreads; ++nThread ) {
+						m_vecthread.emplace_back([this, nThread]() noexcept { worker(nThread); }); // MAYTHROW
+					}
+				} catch (...) {
+					stop();
+					throw;
+				}
+			}
+
+			~thread_pool() {
+				stop();
+			}
+
+			// Number of worker threads. The thread calling run_and_wait participates in the work in addition to the workers.
+			[[nodiscard]] std::size_t thread_count() const& noexcept {
+				return m_vecthread.size();
+			}
+
+			// Calls func(n) for all n in [0, nTasks) concurrently and returns when all calls have returned.
+			// If some calls throw, the exception of the call with the smallest n is rethrown.
+			template<typename Func>
+			void run_and_wait(std::size_t const nTasks, Func&& func) & MAYTHROW {
+				if( 0 == nTasks ) return;
+				thread_pool_detail::batch<std::remove_reference_t<Func>> batch(nTasks, func);
+				// Queue tasks in reverse, so that owners pop them in ascending order and thieves steal the highest indices first.
+				if( auto const nThreadSelf = worker_index() ) {
+					push(*nThreadSelf, nTasks, batch, [](std::size_t) noexcept { return 0; });
+				} else {
+					push(0, nTasks, batch, [&](std::size_t const nTask) noexcept { return nTask % m_vecqueue.size(); });
+				}
+				// Help until no more tasks are queued. All our remaining tasks are then being executed by other threads.
+				while( !thread_pool_detail::batch_access::done(batch) && try_execute_one(worker_index()) ) {}
+				thread_pool_detail::batch_access::wait(batch); // MAYTHROW
+			}
+
+		private:
+			struct task_queue final {
+				std::mutex m_mtx;
+				std::deque<thread_pool_detail::task> m_deqtask;
+			};
+
+			template<typename FuncQueue>
+			void push(std::size_t const nThreadBase, std::size_t const nTasks, thread_pool_detail::batch_base& batch, FuncQueue funcqueue) & noexcept {
+				m_nQueued.fetch_add(nTasks); // before the tasks become visible, so that m_nQueued never underflows
+				for( std::size_t nTask = nTasks; 0 < nTask; ) {
+					--nTask;
+					auto& queue = m_vecqueue[(nThreadBase + funcqueue(nTask)) % m_vecqueue.size()];
+					std::scoped_lock lock(queue.m_mtx);
+					NOBADALLOC(queue.m_deqtask.push_back(thread_pool_detail::task{std::addressof(batch), nTask}));
+				}
+				{
+					std::scoped_lock lock(m_mtx); // see worker: avoids lost wake-ups
+				}
+				m_cv.notify_all();
+			}
+
+			bool try_execute_one(std::optional<std::size_t> const& onThreadSelf) & noexcept {
+				std::optional<thread_pool_detail::task> otask;
+				if( onThreadSelf ) {
+					auto& queue = m_vecqueue[*onThreadSelf];
+					std::scoped_lock lock(queue.m_mtx);
+					if( !queue.m_deqtask.empty() ) {
+						otask.emplace(queue.m_deqtask.back());
+						queue.m_deqtask.pop_back();
+					}
+				}
+				for( std::size_t nOffset = 0; !otask && nOffset < m_vecqueue.size(); ++nOffset ) {
+					auto& queue = m_vecqueue[(onThreadSelf ? *onThreadSelf + 1 + nOffset : nOffset) % m_vecqueue.size()];
+					std::scoped_lock lock(queue.m_mtx);
+					if( !queue.m_deqtask.empty() ) {
+						otask.emplace(queue.m_deqtask.front());
+						queue.m_deqtask.pop_front();
+					}
+				}
+				if( otask ) {
+					m_nQueued.fetch_sub(1);
+					otask->m_pbatch->execute(otask->m_nTask);
+					return true;
+				} else {
+					return false;
+				}
+			}
+
+			void worker(std::size_t const nThread) & noexcept {
+				tc_scoped_assign(worker_identity(), std::make_pair(this, nThread));
+				for( ;; ) {
+					if( !try_execute_one(nThread) ) {
+						std::unique_lock lock(m_mtx);
+						m_cv.wait(lock, [&]() noexcept { return m_bStop || 0 < m_nQueued.load(); });
+						if( m_bStop ) return;
+					}
+				}
+			}
+
+			void stop() & noexcept {
+				{
+					std::scoped_lock lock(m_mtx);
+					m_bStop = true;
+				}
+				m_cv.notify_all();
+				for( auto& thread : m_vecthread ) {
+					thread.join();
+				}
+				m_vecthread.clear();
+			}
+
+			static std::pair<thread_pool const*, std::size_t>& worker_identity() noexcept {
+				thread_local std::pair<thread_pool const*, std::size_t> s_pairpoolnThread(nullptr, 0);
+				return s_pairpoolnThread;
+			}
+
+			std::optional<std::size_t> worker_index() const& noexcept {
+				auto const& pairpoolnThread = worker_identity();
+				if( this == pairpoolnThread.first ) {
+					return pairpoolnThread.second;
+				} else {
+					return std::nullopt;
+				}
+			}
+
+			tc::vector<task_queue> m_vecqueue;
+			tc::vector<std::thread> m_vecthread;
+			std::atomic<std::size_t> m_nQueued{0};
+			std::mutex m_mtx;
+			std::condition_variable m_cv;
+			bool m_bStop = false;
+		};
+	}
+	using no_adl::thread_pool;
+
+	// Process-wide pool with one worker per hardware thread, created on first use.
+	[[nodiscard]] inline tc::thread_pool& default_thread_pool() noexcept {
+		static tc::thread_pool s_threadpool;
+		return s_threadpool;
+	}
+
+	namespace no_adl {
+		// Execution policy of parallel algorithms, e.g., tc::for_each(tc::par, rng, sink).
+		struct par_t final {
+			tc::thread_pool* m_pthreadpool = nullptr; // nullptr: tc::default_thread_pool()
+			std::size_t m_nMinChunkSize = 4096; // smaller amounts of work are not worth a task
+
+			[[nodiscard]] constexpr par_t on(tc::thread_pool& threadpool) const& noexcept {
+				return tc_modified(*this, _.m_pthreadpool = std::addressof(threadpool));
+			}
+
+			[[nodiscard]] constexpr par_t min_chunk_size(std::size_t const nMinChunkSize) const& noexcept {
+				_ASSERT(0 < nMinChunkSize);
+				return tc_modified(*this, _.m_nMinChunkSize = nMinChunkSize);
+			}
+
+			[[nodiscard]] tc::thread_pool& pool() const& noexcept {
+				return m_pthreadpool ? *m_pthreadpool : tc::default_thread_pool();
+			}
+
+			// Number of chunks to split nSize units of work into: enough to balance the load between the threads, but not smaller than m_nMinChunkSize.
+			[[nodiscard]] std::size_t chunk_count(std::size_t const nSize) const& noexcept {
+				return tc::max(tc::min(nSize / m_nMinChunkSize, 4 * (pool().thread_count() + 1)), std::size_t(1));
+			}
+		};
+	}
+	using no_adl::par_t;
+	inline constexpr tc::par_t par{};
+}
@@ -15,6 +15,10 @@
 #include "base/explicit_cast.h"
 #include "base/invoke_with_constant.h"
 #include "optional.h"
+
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+#include <array>
 #include <variant>
 
 /*
@@ -110,7 +114,7 @@ namespace tc {
 		template<typename Overload, typename... Variants>
 		using visit_result_t = tc::type::apply_t<
 			tc::common_reference_prvalue_as_val_t,
-			tc::type::transform_t<
+			tc::type::unique_t<tc::type::transform_t<
 				tc::type::cartesian_product_t<
 					tc::type::transform_t<
 						typename tc::is_instance_or_derived<Variants, std::variant>::arguments,
@@ -118,7 +122,7 @@ namespace tc {
 					>...
 				>,
 				no_adl::overload_result_type<Overload>::template with_arglist
-			>
+			>>
 		>;
 
 
@@ -128,6 +132,95 @@ namespace tc {
 				return tc::invoke(overload, tc_move_if_owned(args)...);
 			};
 		}
+
+		namespace visit_impl {
+			// The combinations of alternatives of Variant... are numbered like the elements of a multi-dimensional array, with
+			// the alternatives of the last variant adjacent.
+			template<typename... Variant>
+			inline constexpr auto c_anStride = []() noexcept {
+				std::array<std::size_t, sizeof...(Variant)> an{std::variant_size<std::remove_cvref_t<Variant>>::value...};
+				std::size_t nStride = 1;
+				for( std::size_t k = sizeof...(Variant); 0 < k; --k ) {
+					nStride *= std::exchange(an[k - 1], nStride);
+				}
+				return an;
+			}();
+
+			template<typename... Variant>
+			inline constexpr std::size_t c_nCombinations = (std::size_t(1) * ... * std::variant_size<std::remove_cvref_t<Variant>>::value);
+
+			template<typename... Variant, std::size_t... k>
+			std::size_t combination(std::index_sequence<k...>, Variant const&... v) noexcept {
+				return ((v.index() * c_anStride<Variant...>[k]) + ... + 0);
+			}
+
+			// The alternative is known to be active, so unlike std::get, there is nothing to check. Otherwise, the checks would
+			// also keep identical code for different alternatives from being merged.
+			template<std::size_t I, typename Variant>
+			decltype(auto) get_active(Variant&& v) noexcept {
+				auto const p = std::get_if<I>(std::addressof(v));
+				_ASSERTDEBUG( p );
+				TC_ASSUME( nullptr != p );
+				return tc::forward_like<Variant>(*p);
+			}
+
+			template<typename Result, std::size_t nCombination, typename Func, typename... Variant, std::size_t... k>
+			Result invoke_alternatives(std::index_sequence<k...>, Func const& func, Variant&&... v) MAYTHROW {
+				return func(get_active<nCombination / c_anStride<Variant...>[k] % std::variant_size<std::remove_cvref_t<Variant>>::value>(std::forward<Variant>(v))...); // MAYTHROW
+			}
+
+			template<typename Result, std::size_t nCombination, typename Func, typename... Variant>
+			Result invoke_combination(Func const& func, Variant&&... v) MAYTHROW {
+				return invoke_alternatives<Result, nCombination>(std::index_sequence_for<Variant...>(), func, std::forward<Variant>(v)...); // MAYTHROW
+			}
+
+			template<typename Result, typename Func, typename... Variant, std::size_t... nCombination>
+			Result invoke_combination_from_table(std::index_sequence<nCombination...>, std::size_t const nCombinationActive, Func const& func, Variant&&... v) MAYTHROW {
+				static constexpr Result(*c_apfn[])(Func const&, Variant&&...) = {
+					invoke_combination<Result, nCombination, Func, Variant...>...
+				};
+				return c_apfn[nCombinationActive](func, std::forward<Variant>(v)...); // MAYTHROW
+			}
+
+			// Up to this many combinations, a switch is inlined into the caller, which compilers turn into a jump table, so the
+			// visitor may be inlined as well. More combinations are dispatched through a table of function pointers, like
+			// tc::invoke_with_constant does.
+			inline constexpr std::size_t c_nMaxSwitchCases = 64;
+
+			template<typename Result, typename Func, typename... Variant>
+			TC_FORCEINLINE inline Result invoke_combination_from_switch(std::size_t const nCombinationActive, Func const& func, Variant&&... v) MAYTHROW {
+				static constexpr std::size_t c_nCombinationsVisited = c_nCombinations<Variant...>;
+				static_assert( c_nCombinationsVisited <= c_nMaxSwitchCases );
+				switch( nCombinationActive ) {
+#define TC_VISIT_CASE(z, n, d) \
+					case n: \
+						if constexpr( n + 1 < c_nCombinationsVisited ) { \
+							return invoke_combination<Result, n>(func, std::forward<Variant>(v)...); /* MAYTHROW */ \
+						} else { \
+							break; \
+						}
+					BOOST_PP_REPEAT(64, TC_VISIT_CASE, _) // c_nMaxSwitchCases
+#undef TC_VISIT_CASE
+					default:
+						break;
+				}
+				// The last combination is the fallback, so the switch needs no unreachable default.
+				return invoke_combination<Result, c_nCombinationsVisited - 1>(func, std::forward<Variant>(v)...); // MAYTHROW
+			}
+
+			// Like std::visit, but without the checks for valueless variants of libstdc++ and libc++, and dispatching to all
+			// combinations of alternatives of multiple variants with a single jump.
+			template<typename Result, typename Func, typename... Variant>
+			TC_FORCEINLINE inline Result visit(Func const& func, Variant&&... v) MAYTHROW {
+				std::size_t const nCombinationActive = combination(std::index_sequence_for<Variant...>(), v...);
+				_ASSERTDEBUG( nCombinationActive < c_nCombinations<Variant...> );
+				if constexpr( c_nCombinations<Variant...> <= c_nMaxSwitchCases ) {
+					return invoke_combination_from_switch<Result>(nCombinationActive, func, std::forward<Variant>(v)...); // MAYTHROW
+				} else {
+					return invoke_combination_from_table<Result>(std::make_index_sequence<c_nCombinations<Variant...>>(), nCombinationActive, func, std::forward<Variant>(v)...); // MAYTHROW
+				}
+			}
+		}
 	}
 
 /*
@@ -180,18 +273,12 @@ namespace tc {
 		struct [[nodiscard]] fn_visit_impl : private Overload {
 			using Overload::Overload;
 			template<typename... Variant>
-			detail::visit_result_t<Overload, Variant...> operator()(Variant&&... v) const& MAYTHROW {
+			TC_FORCEINLINE detail::visit_result_t<Overload, Variant...> operator()(Variant&&... v) const& MAYTHROW {
 				([&]() noexcept { _ASSERTNORETURN( !v.valueless_by_exception() ); tc::discard(v); }(), ...);
-				return
-#ifdef TC_MAC
-					std::__variant_detail::__visitation::__variant::__visit_value // does not throw std::bad_variant_access, which is not supported until macOS 10.14
-#else
-					std::visit
-#endif
-					(
-						detail::projected_result<detail::visit_result_t<Overload, Variant...>>(tc::base_cast<Overload>(*this)),
-						tc::base_cast<typename tc::is_instance_or_derived<Variant, std::variant>::base_instance>(std::forward<Variant>(v))...
-					);
+				return detail::visit_impl::visit<detail::visit_result_t<Overload, Variant...>>(
+					detail::projected_result<detail::visit_result_t<Overload, Variant...>>(tc::base_cast<Overload>(*this)),
+					tc::base_cast<typename tc::is_instance_or_derived<Variant, std::variant>::base_instance>(std::forward<Variant>(v))...
+				); // MAYTHROW
 			}
 		};
 	}
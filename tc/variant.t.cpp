@@ -83,4 +83,63 @@ namespace {
 			_ASSERTEQUAL(tc::get<0>(vart).m_estate, estateCOPIEDONCE);
 		}
 	}
+
+	template<std::size_t... n>
+	auto variant_of_constants(std::index_sequence<n...>) -> std::variant<tc::constant<n>...>;
+
+	template<std::size_t nAlternatives>
+	using variant_of_constants_t = decltype(variant_of_constants(std::make_index_sequence<nAlternatives>()));
+
+	template<std::size_t nAlternatives>
+	variant_of_constants_t<nAlternatives> make_variant_of_constants(std::size_t const n) noexcept {
+		return tc::invoke_with_constant<std::make_index_sequence<nAlternatives>>([](auto constn) noexcept {
+			return variant_of_constants_t<nAlternatives>(std::in_place_index<decltype(constn)::value>);
+		}, n);
+	}
+
+	UNITTESTDEF(fn_visit_many_alternatives) {
+		// within and beyond the alternatives dispatched by switch
+		auto const Value = [](auto const constn) noexcept { return decltype(constn)::value; };
+		for( std::size_t n = 0; n < 40; ++n ) {
+			_ASSERTEQUAL(tc::fn_visit(Value)(make_variant_of_constants<40>(n)), n);
+		}
+		for( std::size_t n = 0; n < 100; ++n ) {
+			_ASSERTEQUAL(tc::fn_visit(Value)(make_variant_of_constants<100>(n)), n);
+		}
+
+		// multiple variants, flattened into 40 * 3 combinations
+		for( std::size_t n0 = 0; n0 < 40; ++n0 ) {
+			for( std::size_t n1 = 0; n1 < 3; ++n1 ) {
+				_ASSERTEQUAL(
+					tc::fn_visit([](auto const constn0, auto const constn1) noexcept { return std::make_pair(decltype(constn0)::value, decltype(constn1)::value); })(
+						make_variant_of_constants<40>(n0),
+						make_variant_of_constants<3>(n1)
+					),
+					std::make_pair(n0, n1)
+				);
+			}
+		}
+		std::variant<int, double> varnf = 1.5;
+		std::variant<char, int, double> const varchnf = 'a';
+		_ASSERTEQUAL(tc::fn_visit([](auto const a, auto const b, auto const c) noexcept { return static_cast<double>(a + b + c); })(varnf, varchnf, std::variant<int>(2)), 1.5 + 'a' + 2);
+	}
+
+	UNITTESTDEF(fn_visit_value_category) {
+		struct derived_variant : std::variant<int, copy_move_tracker1> {
+			using std::variant<int, copy_move_tracker1>::variant;
+		};
+		derived_variant var(std::in_place_index<1>);
+		std::variant<int, long> const varnl = 1;
+		static_assert(std::is_same<decltype(tc::fn_visit([](auto const& t) noexcept -> decltype(auto) { return t; })(varnl)), long>::value);
+
+		tc::fn_visit(
+			[](int&) noexcept { _ASSERTFALSE; },
+			[](copy_move_tracker1& tracker) noexcept { _ASSERTEQUAL(tracker.m_estate, estateONLYMOVED); }
+		)(var);
+		tc::fn_visit(
+			[](int&&) noexcept { _ASSERTFALSE; },
+			[](copy_move_tracker1&& tracker) noexcept { copy_move_tracker1 trackerMoved(tc_move(tracker)); }
+		)(tc_move(var));
+		_ASSERTEQUAL(tc::get<1>(tc::base_cast<std::variant<int, copy_move_tracker1>>(var)).m_estate, estateMOVEDFROM);
+	}
 }